@@ -19,6 +19,7 @@
  *
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include "lib/utils/utils.hpp"
@@ -47,12 +48,14 @@ const bool PBMFrame::switchToNextFrame(const uint16_t currentFrameCounter)
 /* -- -- -- */
 
 LCDPlugin::LCDPlugin()
-	:	_pluginTempo(LCDPluginTempo::TEMPO_DEFAULT),
+	:	_pluginTempo({1000, 10}),
 		_initialized(false),
 		_everLocked(false),
 		_PBMFrameCounter(0),
-		_PBMFrameIndex(0)
+		_PBMFrameIndex(0),
+		_widgetsGeneration(0)
 {
+	this->damageWholePBMFrame();
 }
 
 LCDPlugin::~LCDPlugin()
@@ -81,6 +84,7 @@ void LCDPlugin::resetPBMFrameIndex(void)
 {
 	_itCurrentPBMFrame = _PBMFrames.end();
 	this->checkPBMFrameIndex(); /* may throw */
+	this->damageWholePBMFrame();
 }
 
 const uint64_t LCDPlugin::getPluginID(void) const
@@ -95,18 +99,12 @@ const std::string & LCDPlugin::getPluginName(void) const
 
 const uint16_t LCDPlugin::getPluginTiming(void) const
 {
-	uint16_t timing = 0;
-	uint16_t maxFrames = 0;
-	std::tie(timing, maxFrames) = this->getTempo(_pluginTempo);
-	return timing;
+	return _pluginTempo.framePeriod;
 }
 
 const uint16_t LCDPlugin::getPluginMaxFrames(void) const
 {
-	uint16_t timing = 0;
-	uint16_t maxFrames = 0;
-	std::tie(timing, maxFrames) = this->getTempo(_pluginTempo);
-	return maxFrames;
+	return _pluginTempo.maxFrames;
 }
 
 void LCDPlugin::prepareNextPBMFrame(void)
@@ -120,14 +118,31 @@ void LCDPlugin::prepareNextPBMFrame(void)
 		this->checkPBMFrameIndex(); /* may throw */
 		_PBMFrameIndex = (_itCurrentPBMFrame - _PBMFrames.begin());
 		_PBMFrameCounter = 0;
+		this->damageWholePBMFrame();
 	}
 
 	_PBMFrameCounter++; /* for next call */
+	_widgetsGeneration++;
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
 	GKLog3(trace, this->getPluginName(), " - frameCount #", _PBMFrameCounter)
 #endif
 }
 
+const PBMDamage_type & LCDPlugin::getPBMFrameDamage(void) const
+{
+	return _PBMDamage;
+}
+
+void LCDPlugin::damageWholePBMFrame(void)
+{
+	_PBMDamage.fill(PBM_BAND_FULL_DAMAGE);
+}
+
+void LCDPlugin::clearPBMFrameDamage(void)
+{
+	_PBMDamage.fill(0);
+}
+
 void LCDPlugin::init(FontsManager* const pFonts, const std::string & product)
 {
 	GK_LOG_FUNC
@@ -139,7 +154,7 @@ void LCDPlugin::init(FontsManager* const pFonts, const std::string & product)
 
 const PixelsData & LCDPlugin::getNextPBMFrame(
 	FontsManager* const pFonts,
-	const std::string & LCDKey,
+	const uint64_t LCDKey,
 	const bool lockedPlugin)
 {
 	this->drawPadlockOnPBMFrame(lockedPlugin);
@@ -161,6 +176,19 @@ const LCDPP LCDPlugin::getPluginProperties(void) const
 	return _plugin;
 }
 
+/*
+ * framePeriod is the target period between two frames, clamped to the
+ * LCD screen refresh limit. The plugin is displayed for maxFrames
+ * frames before jumping to the next enabled one.
+ */
+void LCDPlugin::setPluginTempo(
+	const uint16_t framePeriod,
+	const uint16_t maxFrames)
+{
+	_pluginTempo.framePeriod = std::max(framePeriod, static_cast<uint16_t>(LCD_PLUGIN_MIN_FRAME_PERIOD));
+	_pluginTempo.maxFrames = std::max(maxFrames, static_cast<uint16_t>(1));
+}
+
 void LCDPlugin::addPBMFrame(
 	const fs::path & PBMDirectory,
 	const std::string & file,
@@ -171,14 +199,17 @@ void LCDPlugin::addPBMFrame(
 	fs::path filePath(PBMDirectory);
 	filePath /= file;
 
-	this->addPBMEmptyFrame(num);
-
-	this->readPBM(
+	/* throws on failure */
+	const PBMAsset_type PBMData = PBMAssets::getPBM(
 		filePath.string(),
-		_PBMFrames.back()._PBMData,
 		DEFAULT_PBM_WIDTH,
 		DEFAULT_PBM_HEIGHT
 	);
+
+	this->addPBMEmptyFrame(num);
+
+	/* frames are drawn on, so each plugin gets its own copy */
+	_PBMFrames.back()._PBMData = *PBMData;
 }
 
 void LCDPlugin::addPBMEmptyFrame(const uint16_t num)
@@ -218,6 +249,18 @@ void LCDPlugin::writeStringOnPBMFrame(
 {
 	GK_LOG_FUNC
 
+	std::string value( std::to_string(toEnumType(fontID)) );
+	value += ":";
+	value += string;
+
+	if( this->isWidgetUnchanged(PBMXPos, PBMYPos, value) )
+		return;
+
+	uint16_t XPos = 0;
+	uint16_t YPos = 0;
+	uint16_t startXPos = 0;
+	uint16_t charHeight = 0;
+
 	try {
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
 		if(GKLogging::GKDebug) {
@@ -226,8 +269,6 @@ void LCDPlugin::writeStringOnPBMFrame(
 						<< " - writing string : " << string;
 		}
 #endif
-		uint16_t XPos, YPos = 0;
-
 		XPos = (PBMXPos < 0) ? /* centered */
 				pFonts->getCenteredXPos(fontID, string) :
 				static_cast<uint16_t>(PBMXPos);
@@ -236,6 +277,9 @@ void LCDPlugin::writeStringOnPBMFrame(
 				pFonts->getCenteredYPos(fontID) :
 				static_cast<uint16_t>(PBMYPos);
 
+		startXPos = XPos;
+		charHeight = pFonts->getCharacterHeight(fontID);
+
 		for(const char & c : string) {
 			const std::string character(1, c);
 			pFonts->printCharacterOnFrame( fontID, (*_itCurrentPBMFrame)._PBMData, character, XPos, YPos );
@@ -244,6 +288,9 @@ void LCDPlugin::writeStringOnPBMFrame(
 	catch (const GLogiKExcept & e) {
 		GKSysLogWarning(e.what());
 	}
+
+	/* the last printed character may spill over the next PBM bytes */
+	this->damageWidget(PBMXPos, PBMYPos, value, startXPos, YPos, (XPos - startXPos) + 16, charHeight);
 }
 
 void LCDPlugin::writeStringOnLastPBMFrame(
@@ -285,6 +332,11 @@ void LCDPlugin::drawProgressBarOnPBMFrame(
 		return;
 	}
 
+	const std::string value( std::to_string(percent) );
+
+	if( this->isWidgetUnchanged(PBMXPos, PBMYPos, value) )
+		return;
+
 	try {
 		PixelsData & frame = (*_itCurrentPBMFrame)._PBMData;
 
@@ -369,6 +421,9 @@ void LCDPlugin::drawProgressBarOnPBMFrame(
 			drawProgressBarLine(index + (DEFAULT_PBM_WIDTH_IN_BYTES * i), i);
 		}
 		drawHorizontalLine(index + (DEFAULT_PBM_WIDTH_IN_BYTES * (PROGRESS_BAR_HEIGHT-1)));
+
+		/* 13 PBM bytes wide */
+		this->damageWidget(PBMXPos, PBMYPos, value, (xByte * 8), PBMYPos, (13 * 8), PROGRESS_BAR_HEIGHT);
 	}
 	catch (const std::out_of_range& oor) {
 		GKSysLogWarning("wrong frame index");
@@ -380,13 +435,20 @@ void LCDPlugin::drawPadlockOnPBMFrame(
 	const uint16_t PBMXPos,
 	const uint16_t PBMYPos)
 {
+	if( lockedPlugin )
+		_everLocked = true;
+
+	const std::string padlock( lockedPlugin ? "locked" : (_everLocked ? "unlocked" : "none") );
+
+	if( this->isWidgetUnchanged(PBMXPos, PBMYPos, padlock) )
+		return;
+
 	const uint16_t xByte = PBMXPos / 8;
 	const uint16_t index = (DEFAULT_PBM_WIDTH_IN_BYTES * PBMYPos) + xByte;
 
 	PixelsData & frame = (*_itCurrentPBMFrame)._PBMData;
 
 	if( lockedPlugin ) {
-		_everLocked = true;
 		frame[index+(DEFAULT_PBM_WIDTH_IN_BYTES * 0)] = 0b00000000;
 		frame[index+(DEFAULT_PBM_WIDTH_IN_BYTES * 1)] = 0b00110000;
 		frame[index+(DEFAULT_PBM_WIDTH_IN_BYTES * 2)] = 0b01001000;
@@ -412,6 +474,8 @@ void LCDPlugin::drawPadlockOnPBMFrame(
 			frame[index+(DEFAULT_PBM_WIDTH_IN_BYTES * 5)] = 0;
 		}
 	}
+
+	this->damageWidget(PBMXPos, PBMYPos, padlock, PBMXPos, PBMYPos, 8, 6);
 }
 
 void LCDPlugin::drawVerticalLineOnPBMFrame(
@@ -419,6 +483,11 @@ void LCDPlugin::drawVerticalLineOnPBMFrame(
 	const uint16_t PBMYPos,
 	const uint16_t size)
 {
+	const std::string value( std::to_string(size) );
+
+	if( this->isWidgetUnchanged(PBMXPos, PBMYPos, value) )
+		return;
+
 	try {
 		PixelsData & frame = (*_itCurrentPBMFrame)._PBMData;
 
@@ -428,6 +497,8 @@ void LCDPlugin::drawVerticalLineOnPBMFrame(
 		for(uint16_t i = 1; i < size; ++i) {
 			frame[index + (DEFAULT_PBM_WIDTH_IN_BYTES * i)] |= 0b00100000;
 		}
+
+		this->damageWidget(PBMXPos, PBMYPos, value, PBMXPos, PBMYPos, 1, size);
 	}
 	catch (const std::out_of_range& oor) {
 		GKSysLogWarning("wrong frame index");
@@ -462,14 +533,98 @@ void LCDPlugin::checkPBMFrameIndex(void)
 	}
 }
 
-std::tuple<uint16_t, uint16_t> LCDPlugin::getTempo(const LCDPluginTempo tempo)
+/*
+ * Drawing the same value at the same position of the same PBM frame
+ * gives the same pixels, so the widget is skipped and nothing is
+ * damaged. See ::damageWidget() for overlapping widgets.
+ */
+const bool LCDPlugin::isWidgetUnchanged(
+	const int16_t PBMXPos,
+	const int16_t PBMYPos,
+	const std::string & value)
+{
+	auto it = _widgetsCache.find( this->getWidgetKey(PBMXPos, PBMYPos) );
+	if( it == _widgetsCache.end() )
+		return false;
+
+	PBMWidget & widget = it->second;
+	widget.generation = _widgetsGeneration;
+
+	return (widget.value == value);
+}
+
+const uint64_t LCDPlugin::getWidgetKey(
+	const int16_t PBMXPos,
+	const int16_t PBMYPos) const
 {
-	if(tempo == LCDPluginTempo::TEMPO_500_20)
-		return std::make_tuple(500, 20);
-	if(tempo == LCDPluginTempo::TEMPO_400_15)
-		return std::make_tuple(400, 15);
-	/* TEMPO_DEFAULT */
-	return std::make_tuple(1000, 10);
+	return	(static_cast<uint64_t>(_PBMFrameIndex) << 32) |
+			(static_cast<uint64_t>(static_cast<uint16_t>(PBMXPos)) << 16) |
+			(static_cast<uint64_t>(static_cast<uint16_t>(PBMYPos)));
+}
+
+/*
+ * Records the value and the region drawn by the widget, and damages it.
+ * Overlapping widgets of the same PBM frame which were not drawn yet
+ * during this frame were overwritten, so they must be drawn again.
+ * Overlapping widgets already drawn during this frame were below this
+ * one, as they always were.
+ */
+void LCDPlugin::damageWidget(
+	const int16_t PBMXPos,
+	const int16_t PBMYPos,
+	const std::string & value,
+	const uint16_t x,
+	const uint16_t y,
+	const uint16_t width,
+	const uint16_t height)
+{
+	if( (width == 0) or (height == 0) )
+		return;
+
+	const uint64_t key = this->getWidgetKey(PBMXPos, PBMYPos);
+
+	PBMWidget widget;
+	widget.generation = _widgetsGeneration;
+	widget.firstByte = x / 8;
+	widget.lastByte = std::min((x + width - 1) / 8, DEFAULT_PBM_WIDTH_IN_BYTES - 1);
+	widget.firstRow = y;
+	widget.lastRow = std::min((y + height - 1), DEFAULT_PBM_HEIGHT - 1);
+
+	if( (widget.firstByte > widget.lastByte) or (widget.firstRow > widget.lastRow) )
+		return;
+
+	for(auto it = _widgetsCache.begin(); it != _widgetsCache.end(); ) {
+		const PBMWidget & w = it->second;
+		const bool overwritten =
+			(it->first != key) and
+			((it->first >> 32) == _PBMFrameIndex) and
+			(w.generation != _widgetsGeneration) and
+			(w.firstByte <= widget.lastByte) and (widget.firstByte <= w.lastByte) and
+			(w.firstRow <= widget.lastRow) and (widget.firstRow <= w.lastRow);
+
+		if( overwritten )
+			it = _widgetsCache.erase(it);
+		else
+			++it;
+	}
+
+	widget.value = value;
+	_widgetsCache[key] = widget;
+
+	this->damagePBMFrame(widget.firstByte, widget.lastByte, widget.firstRow, widget.lastRow);
+}
+
+void LCDPlugin::damagePBMFrame(
+	const uint16_t firstByte,
+	const uint16_t lastByte,
+	const uint16_t firstRow,
+	const uint16_t lastRow)
+{
+	const uint32_t columns = (((1u << (lastByte - firstByte + 1)) - 1) << firstByte);
+
+	for(unsigned int band = (firstRow / 8); band <= (lastRow / 8u); ++band) {
+		_PBMDamage[band] |= columns;
+	}
 }
 
 } // namespace GLogiK
@@ -24,9 +24,9 @@
 
 #include <cstdint>
 
-#include <tuple>
 #include <vector>
 #include <string>
+#include <map>
 
 #include <boost/filesystem.hpp>
 
@@ -35,17 +35,31 @@
 #include "fontsManager.hpp"
 #include "PBM.hpp"
 #include "PBMFile.hpp"
+#include "PBMAssets.hpp"
 
 namespace fs = boost::filesystem;
 
 namespace GLogiK
 {
 
-enum class LCDPluginTempo : uint8_t
+/* practical LCD screen refresh limit, in milliseconds */
+#define LCD_PLUGIN_MIN_FRAME_PERIOD 20
+
+/* widget drawn on a PBM frame */
+struct PBMWidget
+{
+	std::string value;
+	uint64_t generation;	/* last frame on which the widget was drawn or skipped */
+	uint16_t firstByte;		/* damaged PBM bytes columns and rows */
+	uint16_t lastByte;
+	uint16_t firstRow;
+	uint16_t lastRow;
+};
+
+struct LCDPluginTempo
 {
-	TEMPO_DEFAULT	= 1 << 0,
-	TEMPO_500_20,
-	TEMPO_400_15,
+	uint16_t framePeriod;	/* milliseconds between two frames */
+	uint16_t maxFrames;		/* frames displayed before jumping to next plugin */
 };
 
 class PBMFrame
@@ -88,9 +102,13 @@ class LCDPlugin
 		void resetPBMFrameIndex(void);
 		void prepareNextPBMFrame(void);
 
+		const PBMDamage_type & getPBMFrameDamage(void) const;
+		void damageWholePBMFrame(void);
+		void clearPBMFrameDamage(void);
+
 		virtual const PixelsData & getNextPBMFrame(
 			FontsManager* const pFonts,
-			const std::string & LCDKey,
+			const uint64_t LCDKey,
 			const bool lockedPlugin
 		);
 
@@ -98,7 +116,11 @@ class LCDPlugin
 		LCDPlugin(void);
 
 		LCDPP _plugin;
-		LCDPluginTempo _pluginTempo;
+
+		void setPluginTempo(
+			const uint16_t framePeriod,
+			const uint16_t maxFrames
+		);
 
 		void addPBMFrame(
 			const fs::path & PBMDirectory,
@@ -148,6 +170,7 @@ class LCDPlugin
 		);
 
 	private:
+		LCDPluginTempo _pluginTempo;
 		bool _initialized;
 		bool _everLocked;
 		uint16_t _PBMFrameCounter;	/* frame counter */
@@ -155,8 +178,41 @@ class LCDPlugin
 		std::vector<PBMFrame> _PBMFrames;
 		std::vector<PBMFrame>::iterator _itCurrentPBMFrame;
 
+		/* PBM frame regions drawn since the last LCD buffer dump */
+		PBMDamage_type _PBMDamage;
+		/* last value drawn by each widget, by PBM frame and position */
+		std::map<uint64_t, PBMWidget> _widgetsCache;
+		uint64_t _widgetsGeneration;
+
 		void checkPBMFrameIndex(void);
-		static std::tuple<uint16_t, uint16_t> getTempo(const LCDPluginTempo tempo);
+
+		const bool isWidgetUnchanged(
+			const int16_t PBMXPos,
+			const int16_t PBMYPos,
+			const std::string & value
+		);
+
+		const uint64_t getWidgetKey(
+			const int16_t PBMXPos,
+			const int16_t PBMYPos
+		) const;
+
+		void damageWidget(
+			const int16_t PBMXPos,
+			const int16_t PBMYPos,
+			const std::string & value,
+			const uint16_t x,
+			const uint16_t y,
+			const uint16_t width,
+			const uint16_t height
+		);
+
+		void damagePBMFrame(
+			const uint16_t firstByte,
+			const uint16_t lastByte,
+			const uint16_t firstRow,
+			const uint16_t lastRow
+		);
 };
 
 } // namespace GLogiK
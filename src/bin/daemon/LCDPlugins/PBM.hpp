@@ -22,6 +22,9 @@
 #ifndef SRC_BIN_DAEMON_LCDPLUGINS_PBM_HPP_
 #define SRC_BIN_DAEMON_LCDPLUGINS_PBM_HPP_
 
+#include <cstdint>
+
+#include <array>
 #include <vector>
 
 /* LCD screen real sizes in pixels */
@@ -35,6 +38,9 @@
 
 #define		  DEFAULT_PBM_DATA_IN_BYTES		(DEFAULT_PBM_WIDTH_IN_BYTES * DEFAULT_PBM_HEIGHT)
 
+/* all PBM bytes columns of one 8-rows band */
+#define			  PBM_BAND_FULL_DAMAGE		((1u << DEFAULT_PBM_WIDTH_IN_BYTES) - 1)
+
 /* LCD header length */
 #define			 LCD_DATA_HEADER_OFFSET		32
 
@@ -47,6 +53,11 @@ namespace GLogiK
 
 typedef std::vector<unsigned char> PixelsData;
 
+/* for each 8-rows band, bitmask of the damaged PBM bytes columns */
+typedef std::array<uint32_t, DEFAULT_PBM_HEIGHT_IN_BYTES> PBMDamage_type;
+
+static_assert(DEFAULT_PBM_WIDTH_IN_BYTES < 32, "PBM bytes columns must fit in a band damage mask");
+
 } // namespace GLogiK
 
 #endif
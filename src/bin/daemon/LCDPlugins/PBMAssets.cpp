@@ -0,0 +1,103 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <new>
+
+#include "lib/utils/utils.hpp"
+
+#include "PBMAssets.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+std::mutex PBMAssets::_assetsMutex;
+std::map<std::string, PBMAsset_type> PBMAssets::_PBMs;
+std::map<FontID, PBMFontAsset_type> PBMAssets::_fonts;
+
+const PBMAsset_type PBMAssets::getPBM(
+	const std::string & PBMPath,
+	const uint16_t PBMWidth,
+	const uint16_t PBMHeight)
+{
+	GK_LOG_FUNC
+
+	std::lock_guard<std::mutex> lock(_assetsMutex);
+
+	auto it = _PBMs.find(PBMPath);
+	if( it != _PBMs.end() )
+		return (*it).second;
+
+	std::shared_ptr<PixelsData> PBMData;
+	try {
+		PBMData = std::make_shared<PixelsData>( (PBMWidth / 8) * PBMHeight, 0 );
+	}
+	catch (const std::bad_alloc& e) { /* handle new() failure */
+		throw GLogiKBadAlloc("PBM asset bad allocation");
+	}
+
+	PBMAssets::readPBM(PBMPath, *PBMData, PBMWidth, PBMHeight); /* throws on failure */
+
+	GKLog2(trace, "cached PBM asset : ", PBMPath)
+
+	_PBMs[PBMPath] = PBMData;
+	return PBMData;
+}
+
+const PBMFontAsset_type PBMAssets::getFont(const FontID fontID)
+{
+	GK_LOG_FUNC
+
+	std::lock_guard<std::mutex> lock(_assetsMutex);
+
+	auto it = _fonts.find(fontID);
+	if( it != _fonts.end() )
+		return (*it).second;
+
+	GKLog2(trace, "initializing font ", toUInt(toEnumType(fontID)))
+
+	PBMFontAsset_type font;
+	try {
+		switch(fontID) {
+			case FontID::MONOSPACE85:
+				font = std::make_shared<const FontMonospace85>();
+				break;
+			case FontID::MONOSPACE86:
+				font = std::make_shared<const FontMonospace86>();
+				break;
+			case FontID::DEJAVUSANSBOLD1616:
+				font = std::make_shared<const FontDejaVuSansBold1616>();
+				break;
+			default:
+				throw GLogiKExcept("unknown font ID");
+		}
+	}
+	catch (const std::bad_alloc& e) { /* handle new() failure */
+		throw GLogiKBadAlloc("font bad allocation");
+	}
+
+	_fonts[fontID] = font;
+	return font;
+}
+
+} // namespace GLogiK
+
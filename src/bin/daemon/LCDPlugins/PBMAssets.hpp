@@ -0,0 +1,72 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_BIN_DAEMON_LCDPLUGINS_PBM_ASSETS_HPP_
+#define SRC_BIN_DAEMON_LCDPLUGINS_PBM_ASSETS_HPP_
+
+#include <cstdint>
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "PBM.hpp"
+#include "PBMFile.hpp"
+#include "PBMFont.hpp"
+#include "fonts.hpp"
+
+namespace GLogiK
+{
+
+typedef std::shared_ptr<const PixelsData> PBMAsset_type;
+typedef std::shared_ptr<const PBMFont> PBMFontAsset_type;
+
+/*
+ * Process-wide cache of PBM files and fonts. Assets are read
+ * once from disk, then shared read-only by all devices plugins
+ * managers, and kept across devices restarts.
+ */
+class PBMAssets
+	:	virtual private PBMFile
+{
+	public:
+		/* both throw GLogiKExcept on failure */
+		static const PBMAsset_type getPBM(
+			const std::string & PBMPath,
+			const uint16_t PBMWidth,
+			const uint16_t PBMHeight
+		);
+		static const PBMFontAsset_type getFont(const FontID fontID);
+
+	protected:
+
+	private:
+		PBMAssets(void) = delete;
+
+		static std::mutex _assetsMutex;
+		static std::map<std::string, PBMAsset_type> _PBMs;
+		static std::map<FontID, PBMFontAsset_type> _fonts;
+};
+
+} // namespace GLogiK
+
+#endif
@@ -22,6 +22,7 @@
 //#include <bitset>
 #include <sstream>
 #include <stdexcept>
+#include <tuple>
 
 #include <boost/filesystem.hpp>
 
@@ -79,8 +80,6 @@ PBMFont::PBMFont(
 		_shiftCharBase(((charWidth % 8) == 0) ? 8 : charWidth),
 		_fontLeftShift(fontLeftShift),
 		_extraLeftShift(extraLeftShift),
-		_charX(0),
-		_charY(0),
 		_charsMap(charsMap)
 {
 	GK_LOG_FUNC
@@ -108,7 +107,7 @@ PBMFont::~PBMFont()
 	GKLog2(trace, "deleting font ", _fontName)
 }
 
-const uint16_t PBMFont::getCenteredXPos(const std::string & string)
+const uint16_t PBMFont::getCenteredXPos(const std::string & string) const
 {
 	uint16_t XPos = LCD_SCREEN_WIDTH;
 	for(const char & c : string) {
@@ -123,24 +122,31 @@ const uint16_t PBMFont::getCenteredXPos(const std::string & string)
 	return static_cast<uint16_t>(XPos/2);
 }
 
-const uint16_t PBMFont::getCenteredYPos(void)
+const uint16_t PBMFont::getCenteredYPos(void) const
 {
 	uint16_t YPos = LCD_SCREEN_HEIGHT;
 	YPos -= _charHeight;
 	return static_cast<uint16_t>(YPos/2);
 }
 
+const uint16_t PBMFont::getCharacterHeight(void) const
+{
+	return _charHeight;
+}
+
 void PBMFont::printCharacterOnFrame(
 	PixelsData & frame,
 	const std::string & character,
 	uint16_t & PBMXPos,
-	const uint16_t PBMYPos)
+	const uint16_t PBMYPos) const
 {
 	GK_LOG_FUNC
 
+	/* fonts are shared between devices threads, no internal state here */
+	uint16_t charX, charY = 0;
+
 	try {
-		_charX = _charsMap.at(character).first;
-		_charY = _charsMap[character].second;
+		std::tie(charX, charY) = _charsMap.at(character);
 	}
 	catch (const std::out_of_range& oor) {
 		std::ostringstream warn(_fontName, std::ios_base::app);
@@ -181,7 +187,7 @@ void PBMFont::printCharacterOnFrame(
 	try {
 		for(uint16_t i = 0; i < _charHeight; i++) {
 			for(uint16_t j = 0; j < _charBytes; j++) {
-				const unsigned char c = this->getCharacterLine(i, j);
+				const unsigned char c = this->getCharacterLine(i, j, charX, charY);
 				index = (DEFAULT_PBM_WIDTH_IN_BYTES * (PBMYPos+i)) + xByte + j;
 
 				frame.at(index) &= (0b11111111 << xModuloComp8);
@@ -214,28 +220,32 @@ void PBMFont::printCharacterOnFrame(
 
 }
 
-const unsigned char PBMFont::getCharacterLine(const uint16_t line, const uint16_t charByte) const
+const unsigned char PBMFont::getCharacterLine(
+	const uint16_t line,
+	const uint16_t charByte,
+	const uint16_t charX,
+	const uint16_t charY) const
 {
 	GK_LOG_FUNC
 
 	unsigned char c = 0;
 	const uint16_t i =
 		/* PBM_Y_line which contains the character (in bytes) */
-		(_charY * _charHeight * (_PBMWidth / 8)) +
+		(charY * _charHeight * (_PBMWidth / 8)) +
 		/* character's PBM_X position on the PBM_Y_line (in bytes) */
-		( (_charX * _charWidth) / 8 ) +
+		( (charX * _charWidth) / 8 ) +
 		/* line in the selected character (in bytes) */
 		line * (_PBMWidth / 8);
 
 #if 0 && DEBUGGING_ON
-	LOG(trace)	<< "charX: " << _charX
-				<< " charY: " << _charY;
+	LOG(trace)	<< "charX: " << charX
+				<< " charY: " << charY;
 				<< " index: " << i+1;
 #endif
 
 	try {
 		if(_charWidth == 6) {
-			switch( (_charX % 4) ) {
+			switch( (charX % 4) ) {
 				case 0 :
 					c = (_PBMData.at(i) >> 2);
 					break;
@@ -253,7 +263,7 @@ const unsigned char PBMFont::getCharacterLine(const uint16_t line, const uint16_
 			}
 		}
 		else if(_charWidth == 5) {
-			switch( (_charX % 8) ) {
+			switch( (charX % 8) ) {
 				case 0:
 					c = (_PBMData.at(i) >> 3);
 					break;
@@ -294,7 +304,7 @@ const unsigned char PBMFont::getCharacterLine(const uint16_t line, const uint16_
 		error << " - wrong index : ";
 		error << oor.what();
 		error << " - char_width: " << std::to_string(_charWidth);
-		error << " - charX: " << std::to_string(_charX);
+		error << " - charX: " << std::to_string(charX);
 		GKSysLogError(error.str());
 	}
 
@@ -45,15 +45,16 @@ class PBMFont
 
 		static const std::string deg;
 
-		const uint16_t getCenteredXPos(const std::string & string);
-		const uint16_t getCenteredYPos(void);
+		const uint16_t getCenteredXPos(const std::string & string) const;
+		const uint16_t getCenteredYPos(void) const;
+		const uint16_t getCharacterHeight(void) const;
 
 		void printCharacterOnFrame(
 			PixelsData & frame,
 			const std::string & character,
 			uint16_t & PBMXPos,
 			const uint16_t PBMYPos
-		);
+		) const;
 
 	protected:
 		PBMFont(
@@ -78,8 +79,6 @@ class PBMFont
 		const uint16_t _shiftCharBase;
 		const uint16_t _fontLeftShift;
 		const uint16_t _extraLeftShift;
-		uint16_t _charX;
-		uint16_t _charY;
 
 		std::map<std::string, std::pair<uint16_t, uint16_t>> _charsMap;
 
@@ -88,7 +87,9 @@ class PBMFont
 
 		const unsigned char getCharacterLine(
 			const uint16_t line,
-			const uint16_t charByte
+			const uint16_t charByte,
+			const uint16_t charX,
+			const uint16_t charY
 		) const;
 };
 
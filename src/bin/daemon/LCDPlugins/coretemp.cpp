@@ -22,6 +22,7 @@
 #include <cstdint>
 
 #include <string>
+#include <memory>
 
 #include <boost/filesystem.hpp>
 
@@ -110,12 +111,14 @@ Coretemp::Coretemp(const std::string & coretempID)
 	_plugin.setID( toEnumType(LCDScreenPlugin::GK_LCD_CORETEMP) );
 	_plugin.setName("coretemp");
 	_plugin.setDesc("Coretemp plugin, used to get packages/cores temperatures from Intel CPUs");
-	_pluginTempo = LCDPluginTempo::TEMPO_500_20;
+	this->setPluginTempo(500, 20);
 	_coretempID = coretempID;
 }
 
 Coretemp::~Coretemp()
 {
+	if( ! _hwmonID.empty() )
+		SystemStatsSampler::removeHwmonDirectory(_hwmonID);
 }
 
 void Coretemp::init(FontsManager* const pFonts, const std::string & product)
@@ -134,6 +137,9 @@ void Coretemp::init(FontsManager* const pFonts, const std::string & product)
 
 	GKLog2(trace, "hwmon root directory: ", _hwmonID)
 
+	if( ! _hwmonID.empty() )
+		SystemStatsSampler::addHwmonDirectory(_hwmonID);
+
 	this->writeStringOnLastPBMFrame(pFonts, FontID::MONOSPACE85, "intel cpu temperatures", 16, 1);
 
 	LCDPlugin::init(pFonts, product);
@@ -141,74 +147,24 @@ void Coretemp::init(FontsManager* const pFonts, const std::string & product)
 
 const PixelsData & Coretemp::getNextPBMFrame(
 	FontsManager* const pFonts,
-	const std::string & LCDKey,
+	const uint64_t LCDKey,
 	const bool lockedPlugin)
 {
 	GK_LOG_FUNC
 
 	this->drawPadlockOnPBMFrame(lockedPlugin);
 
-	struct dev {
-		std::string fullstr;
-		std::string input;
-		std::string label;
-		std::string id;
-		bool isPkg;
-	};
-
-	std::vector<dev> hwmon;
-	
-	try {
-		unsigned short x = 1;
-
-		std::ifstream infile;
-		infile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-		while(true) {
-			std::string inputFile = _hwmonID;
-			inputFile += "/temp";
-			inputFile += std::to_string(x);
-			inputFile += "_input";
-		
-			std::string labelFile = _hwmonID;
-			labelFile += "/temp";
-			labelFile += std::to_string(x);
-			labelFile += "_label";
-		
-			dev device;
-
-			infile.open(inputFile);
-			std::getline(infile, device.input);
-			infile.close();
-
-			infile.open(labelFile);
-			std::getline(infile, device.label);
-			infile.close();
-
-			device.isPkg = (device.label.substr(0, 11) == "Package id ") ? true : false;
-			device.id = (device.isPkg) ? device.label.substr(11) : device.label.substr(5);
-
-			auto & s = device.fullstr;
-			s  = device.label; s += " ";
-			s += device.input; s += " ";
-			s += device.id;    s += " ";
-			s += (device.isPkg) ? "pkg: true" : "pkg: false";
-
-			hwmon.push_back(device);
+	/* sampled by the shared system stats thread */
+	const std::shared_ptr<const SystemStatsSnapshot> stats( SystemStatsSampler::getSnapshot() );
 
-			x++;
-		}
-	}
-	catch (const std::ifstream::failure & e) {
-#if DEBUGGING_ON && DEBUG_LCD_PLUGINS
-		GKLog2(trace, "hwmon size: ", hwmon.size())
-#endif
-		if( hwmon.empty() ) {
-			GKSysLogError("error opening/reading/closing file : ", e.what());
-			throw GLogiKExcept("ifstream error");
-		}
+	/* not sampled yet, or sensors reading failure (logged by the sampler) */
+	const auto it = stats->hwmon.find(_hwmonID);
+	if( (it == stats->hwmon.cend()) or it->second.empty() ) {
+		return LCDPlugin::getCurrentPBMFrame();
 	}
 
+	const std::vector<HwmonSensor> & hwmon = it->second;
+
 	const uint16_t TEMP_POS_X = 36;
 	const uint16_t TEMP_POS_Y = 22;
 
@@ -232,7 +188,7 @@ const PixelsData & Coretemp::getNextPBMFrame(
 		}
 
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
-		GKLog2(trace, "device: ", device.fullstr)
+		GKLog4(trace, "device: ", device.id, device.input, (device.isPkg ? " pkg: true" : " pkg: false"))
 #endif
 
 		std::string temp(device.id);
@@ -28,6 +28,7 @@
 #include "fontsManager.hpp"
 
 #include "LCDPlugin.hpp"
+#include "systemStatsSampler.hpp"
 
 namespace GLogiK
 {
@@ -46,7 +47,7 @@ class Coretemp
 
 		const PixelsData & getNextPBMFrame(
 			FontsManager* const pFonts,
-			const std::string & LCDKey,
+			const uint64_t LCDKey,
 			const bool lockedPlugin
 		);
 
@@ -44,7 +44,7 @@ Endscreen::Endscreen()
 	_plugin.setID( toEnumType(LCDScreenPlugin::GK_LCD_ENDSCREEN) );
 	_plugin.setName("endscreen");
 	_plugin.setDesc("Endscreen plugin, used when releasing a device");
-	//_pluginTempo = LCDPluginTempo::TEMPO_DEFAULT;
+	//this->setPluginTempo(1000, 10);
 }
 
 Endscreen::~Endscreen()
@@ -19,8 +19,6 @@
  *
  */
 
-#include <new>
-
 #include "lib/utils/utils.hpp"
 
 #include "fontsManager.hpp"
@@ -36,9 +34,6 @@ FontsManager::FontsManager()
 
 FontsManager::~FontsManager()
 {
-	for(const auto & font_pair : _fonts) {
-		delete font_pair.second;
-	}
 	_fonts.clear();
 }
 
@@ -66,6 +61,17 @@ const uint16_t FontsManager::getCenteredYPos(const FontID fontID)
 	}
 }
 
+const uint16_t FontsManager::getCharacterHeight(const FontID fontID)
+{
+	try {
+		return _fonts.at(fontID)->getCharacterHeight();
+	}
+	catch (const std::out_of_range& oor) {
+		this->initializeFont(fontID);
+		return _fonts.at(fontID)->getCharacterHeight();
+	}
+}
+
 void FontsManager::printCharacterOnFrame(
 	const FontID fontID,
 	PixelsData & frame,
@@ -86,29 +92,8 @@ void FontsManager::initializeFont(const FontID fontID)
 {
 	GK_LOG_FUNC
 
-	GKLog2(trace, "initializing font ", toUInt(toEnumType(fontID)))
-
-	PBMFont* font = nullptr;
-	try {
-		switch(fontID) {
-			case FontID::MONOSPACE85:
-				font = new FontMonospace85();
-				break;
-			case FontID::MONOSPACE86:
-				font = new FontMonospace86();
-				break;
-			case FontID::DEJAVUSANSBOLD1616:
-				font = new FontDejaVuSansBold1616();
-				break;
-			default:
-				throw GLogiKExcept("unknown font ID");
-		}
-	}
-	catch (const std::bad_alloc& e) { /* handle new() failure */
-		throw GLogiKBadAlloc("font bad allocation");
-	}
-
-	_fonts[fontID] = font;
+	/* throws on failure */
+	_fonts[fontID] = PBMAssets::getFont(fontID);
 }
 
 } // namespace GLogiK
@@ -28,6 +28,7 @@
 #include <map>
 
 #include "PBMFont.hpp"
+#include "PBMAssets.hpp"
 #include "fonts.hpp"
 
 namespace GLogiK
@@ -45,6 +46,7 @@ class FontsManager
 		);
 
 		const uint16_t getCenteredYPos(const FontID fontID);
+		const uint16_t getCharacterHeight(const FontID fontID);
 
 		void printCharacterOnFrame(
 			const FontID fontID,
@@ -57,7 +59,8 @@ class FontsManager
 	protected:
 
 	private:
-		std::map<FontID, PBMFont*> _fonts;
+		/* fonts are shared, see PBMAssets */
+		std::map<FontID, PBMFontAsset_type> _fonts;
 
 		void initializeFont(const FontID fontID);
 };
@@ -24,7 +24,6 @@
 #include <fstream>
 #include <stdexcept>
 #include <chrono>
-#include <thread>
 #include <iomanip>
 
 #include <boost/filesystem.hpp>
@@ -40,55 +39,73 @@ namespace GLogiK
 using namespace NSGKUtils;
 
 NetSnapshots::NetSnapshots()
-	:	_rxDiff(0),
-		_txDiff(0),
-		_defaultNetworkInterfaceName(""),
+	:	_rxBytes(0),
+		_txBytes(0),
+		_rxRate(0),
+		_txRate(0),
 		_networkInterfaceName("")
+{
+}
+
+NetSnapshots::~NetSnapshots()
+{
+}
+
+/* rates are computed between two successive calls, the first call
+ * after a default route interface change only records the counters */
+void NetSnapshots::update(void)
 {
 	GK_LOG_FUNC
 
-	this->findDefaultRouteNetworkInterfaceName();
+	const std::string interfaceName( this->findDefaultRouteNetworkInterfaceName() );
 
-	if( _defaultNetworkInterfaceName.empty() ) {
+	if( interfaceName.empty() ) {
 		throw GLogiKExcept("unable to find default route interface name");
 	}
 
-#if DEBUGGING_ON && DEBUG_LCD_PLUGINS
-	GKLog2(trace, "found default route interface name : ", _defaultNetworkInterfaceName)
-#endif
-
-	_networkInterfaceName = _defaultNetworkInterfaceName;
-
-	unsigned long long s1, s2 = 0;
-	unsigned long long s3, s4 = 0;
-	this->setBytesSnapshotValue(NetDirection::NET_RX, s1);
-	this->setBytesSnapshotValue(NetDirection::NET_TX, s3);
-	std::this_thread::sleep_for(std::chrono::milliseconds(100));
-	this->setBytesSnapshotValue(NetDirection::NET_RX, s2);
-	this->setBytesSnapshotValue(NetDirection::NET_TX, s4);
-	if( (s1 == 0) or (s2 == 0) )
+	unsigned long long rx = 0;
+	unsigned long long tx = 0;
+	this->setBytesSnapshotValue(interfaceName, NetDirection::NET_RX, rx);
+	this->setBytesSnapshotValue(interfaceName, NetDirection::NET_TX, tx);
+	if(rx == 0)
 		throw GLogiKExcept("wrong RX bytes snapshot");
-	if( (s3 == 0) or (s4 == 0) )
+	if(tx == 0)
 		throw GLogiKExcept("wrong TX bytes snapshot");
-	_rxDiff = (10 * (s2 - s1)); /* extrapolation */
-	_txDiff = (10 * (s4 - s3)); /* extrapolation */
-}
 
-NetSnapshots::~NetSnapshots()
-{
+	const auto now = std::chrono::steady_clock::now();
+
+	if( (interfaceName == _networkInterfaceName) and (rx >= _rxBytes) and (tx >= _txBytes) ) {
+		const float elapsed = std::chrono::duration<float>(now - _lastUpdate).count();
+		if(elapsed > 0.f) {
+			_rxRate = static_cast<unsigned long long>((rx - _rxBytes) / elapsed);
+			_txRate = static_cast<unsigned long long>((tx - _txBytes) / elapsed);
+		}
+	}
+	else {
+#if DEBUGGING_ON && DEBUG_LCD_PLUGINS
+		GKLog2(trace, "found default route interface name : ", interfaceName)
+#endif
+		_rxRate = 0;
+		_txRate = 0;
+	}
+
+	_networkInterfaceName = interfaceName;
+	_rxBytes = rx;
+	_txBytes = tx;
+	_lastUpdate = now;
 }
 
-const std::string NetSnapshots::getRateString(NetDirection direction)
+const unsigned long long NetSnapshots::getRate(const NetDirection direction) const
 {
 	if(direction == NetDirection::NET_RX)
-		return this->getRateString(_rxDiff, " - download");
+		return _rxRate;
 	else
-		return this->getRateString(_txDiff, " - upload  ");
+		return _txRate;
 }
 
 const std::string NetSnapshots::getRateString(
-	unsigned long long value,
-	const std::string & direction)
+	const unsigned long long value,
+	const NetDirection direction)
 {
 	std::ostringstream buffer("", std::ios_base::app);
 	std::string unit;
@@ -121,14 +138,16 @@ const std::string NetSnapshots::getRateString(
 	}
 
 	out += unit;
-	out += direction;
+	out += (direction == NetDirection::NET_RX) ? " - download" : " - upload  ";
 	return out;
 }
 
-void NetSnapshots::findDefaultRouteNetworkInterfaceName(void)
+const std::string NetSnapshots::findDefaultRouteNetworkInterfaceName(void)
 {
 	GK_LOG_FUNC
 
+	std::string interfaceName;
+
 	try {
 		std::ifstream routeFile("/proc/net/route");
 
@@ -140,8 +159,8 @@ void NetSnapshots::findDefaultRouteNetworkInterfaceName(void)
 			boost::split(results, line, [](char c){return c == '\t';});
 
 			if(results.at(1) == "00000000") { /* default route */
-				_defaultNetworkInterfaceName = results[0];
-				return;
+				interfaceName = results[0];
+				break;
 			}
 		}
 	}
@@ -151,15 +170,20 @@ void NetSnapshots::findDefaultRouteNetworkInterfaceName(void)
 	catch (const std::ifstream::failure & e) {
 		GKLog2(error, "error opening/reading/closing kernel route file : ", e.what());
 	}
+
+	return interfaceName;
 }
 
-void NetSnapshots::setBytesSnapshotValue(const NetDirection d, unsigned long long & value)
+void NetSnapshots::setBytesSnapshotValue(
+	const std::string & interfaceName,
+	const NetDirection d,
+	unsigned long long & value)
 {
 	GK_LOG_FUNC
 
 	try {
 		fs::path file("/sys/class/net");
-		file /= _networkInterfaceName;
+		file /= interfaceName;
 		file /= "statistics";
 		if(d == NetDirection::NET_RX)
 			file /= "rx_bytes";
@@ -22,6 +22,7 @@
 #ifndef SRC_BIN_DAEMON_LCDPLUGINS_NETSNAP_NET_SNAPSHOTS_HPP_
 #define SRC_BIN_DAEMON_LCDPLUGINS_NETSNAP_NET_SNAPSHOTS_HPP_
 
+#include <chrono>
 #include <string>
 
 namespace GLogiK
@@ -39,20 +40,29 @@ class NetSnapshots
 		NetSnapshots(void);
 		~NetSnapshots(void);
 
-		const std::string getRateString(NetDirection direction);
+		void update(void);
+		const unsigned long long getRate(const NetDirection direction) const;
+
+		static const std::string getRateString(
+			const unsigned long long rate,
+			const NetDirection direction
+		);
 
 	protected:
 
 	private:
-		unsigned long long _rxDiff;
-		unsigned long long _txDiff;
-		std::string _defaultNetworkInterfaceName;
+		unsigned long long _rxBytes;
+		unsigned long long _txBytes;
+		unsigned long long _rxRate;
+		unsigned long long _txRate;
+		std::chrono::steady_clock::time_point _lastUpdate;
 		std::string _networkInterfaceName;
-		void findDefaultRouteNetworkInterfaceName(void);
-		void setBytesSnapshotValue(const NetDirection d, unsigned long long & value);
-		const std::string getRateString(
-			unsigned long long value,
-			const std::string & direction
+
+		const std::string findDefaultRouteNetworkInterfaceName(void);
+		void setBytesSnapshotValue(
+			const std::string & interfaceName,
+			const NetDirection d,
+			unsigned long long & value
 		);
 };
 
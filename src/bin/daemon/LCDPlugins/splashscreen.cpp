@@ -44,7 +44,7 @@ Splashscreen::Splashscreen()
 	_plugin.setID( toEnumType(LCDScreenPlugin::GK_LCD_SPLASHSCREEN) );
 	_plugin.setName("splashscreen");
 	_plugin.setDesc("Splashscreen plugin, used when initializing a device");
-	_pluginTempo = LCDPluginTempo::TEMPO_400_15;
+	this->setPluginTempo(400, 15);
 }
 
 Splashscreen::~Splashscreen()
@@ -19,19 +19,14 @@
  *
  */
 
-#include <cmath>
-#include <cfenv>
-
 #include <unistd.h>
 #include <cstdint>
 #include <climits>
 
 #include <iomanip>
 #include <sstream>
-#include <fstream>
 #include <string>
-#include <vector>
-#include <map>
+#include <memory>
 
 #include <config.h>
 
@@ -54,7 +49,7 @@ SystemMonitor::SystemMonitor()
 	_plugin.setID( toEnumType(LCDScreenPlugin::GK_LCD_SYSTEM_MONITOR) );
 	_plugin.setName("systemMonitor");
 	_plugin.setDesc("CPU, network and memory monitoring plugin");
-	_pluginTempo = LCDPluginTempo::TEMPO_500_20;
+	this->setPluginTempo(500, 20);
 }
 
 SystemMonitor::~SystemMonitor()
@@ -83,7 +78,7 @@ void SystemMonitor::init(FontsManager* const pFonts, const std::string & product
 
 const PixelsData & SystemMonitor::getNextPBMFrame(
 	FontsManager* const pFonts,
-	const std::string & LCDKey,
+	const uint64_t LCDKey,
 	const bool lockedPlugin
 	)
 {
@@ -91,8 +86,8 @@ const PixelsData & SystemMonitor::getNextPBMFrame(
 
 	this->drawPadlockOnPBMFrame(lockedPlugin);
 
-	/* -- -- -- */
-	std::string usedPhysicalMemory("");
+	/* sampled by the shared system stats thread */
+	const std::shared_ptr<const SystemStatsSnapshot> stats( SystemStatsSampler::getSnapshot() );
 
 	auto getPaddedPercentString = [] (unsigned int i) -> const std::string {
 		std::ostringstream out("", std::ios_base::app);
@@ -100,102 +95,13 @@ const PixelsData & SystemMonitor::getNextPBMFrame(
 		return out.str();
 	};
 
-	{
-		std::map<std::string, std::vector<std::string>> memShot;
-
-		uint64_t freePMem = 0;
-		uint64_t totalPMem = 1;
-
-		try {
-			std::ifstream meminfo("/proc/meminfo");
-			std::string line;
-			while( std::getline(meminfo, line) )
-			{
-				const char delim = ' ';
-				std::vector<std::string> words;
-				const std::vector<std::string> memItems = {"MemTotal", "MemFree", "MemAvailable", "Buffers", "Cached"};
-
-				std::stringstream ss(line);
-				std::string word;
-				while( std::getline(ss, word, delim) ) {
-					if( ! word.empty() )
-						words.push_back(word);
-			    }
-
-				if( ! words.empty() ) {
-					for(const auto & item : memItems) {
-						const std::string & s = words[0];
-						if( s.substr(0, s.size()-1) == item ) {
-							memShot.insert( std::pair<std::string, std::vector<std::string>>(item, words));
-						}
-					}
-				}
-
-				if( memShot.size() == memItems.size() ) {
-					//LOG(trace) << "found each item :-)";
-					break;
-				}
-			}
-		}
-		catch (const std::ifstream::failure & e) {
-			GKSysLogError("error opening/reading/closing /proc/meminfo : ", e.what());
-			throw GLogiKExcept("ifstream error");
-		}
-
-		try {
-			totalPMem = toULL( memShot.at("MemTotal").at(1) );
-
-			// Linux Kernel 3.14+
-			if( memShot.count("MemAvailable") == 1 ) {
-				freePMem  = toULL( memShot["MemAvailable"].at(1) );
-			}
-			else {
-				freePMem  = toULL( memShot.at("MemFree").at(1) );
-				freePMem += toULL( memShot.at("Buffers").at(1) );
-				freePMem += toULL( memShot.at("Cached").at(1) );
-			}
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogWarning("meminfo parsing problem : ", oor.what());
-			freePMem = 0;
-		}
-		catch (const GLogiKExcept & e) {
-			GKSysLogWarning("meminfo conversion failure : ", e.what());
-			freePMem = 0;
-		}
-
-		float freeMem = 100 * freePMem / totalPMem;
-		std::fesetround(FE_TONEAREST);
-		freeMem = std::nearbyint(freeMem);
-
-		uint16_t usedMem = static_cast<uint16_t>(freeMem);
-		usedMem = 100 - usedMem;
-
-		this->drawProgressBarOnPBMFrame(usedMem, 24, 33);
-		usedPhysicalMemory = getPaddedPercentString(usedMem);
-	}
-
 	/* -- -- -- */
-	std::string usedCPUActiveTotal("");
-
-	{
-		CPUSnapshot s2;
-
-		/* see cpu-stat - CPUStatsPrinter::GetPercActiveTotal() */
-		const float ACTIVE_TIME		= s2.GetActiveTimeTotal() - _snapshot1.GetActiveTimeTotal();
-		const float IDLE_TIME		= s2.GetIdleTimeTotal() - _snapshot1.GetIdleTimeTotal();
-		const float TOTAL_TIME		= ACTIVE_TIME + IDLE_TIME;
-
-		float cpuPercentTotal = 100.f * ACTIVE_TIME / TOTAL_TIME;
-
-		std::fesetround(FE_TONEAREST);
-		cpuPercentTotal = std::nearbyint(cpuPercentTotal);
-
-		this->drawProgressBarOnPBMFrame(cpuPercentTotal, 24, 15);
-		usedCPUActiveTotal = getPaddedPercentString(cpuPercentTotal);
+	this->drawProgressBarOnPBMFrame(stats->usedMemory, 24, 33);
+	const std::string usedPhysicalMemory( getPaddedPercentString(stats->usedMemory) );
 
-		_snapshot1 = s2;
-	}
+	/* -- -- -- */
+	this->drawProgressBarOnPBMFrame(stats->CPUActiveTotal, 24, 15);
+	const std::string usedCPUActiveTotal( getPaddedPercentString(stats->CPUActiveTotal) );
 
 	/* -- -- -- */
 	auto getPaddedRateString = [] (
@@ -214,33 +120,29 @@ const PixelsData & SystemMonitor::getNextPBMFrame(
 		return paddedNetRateString;
 	};
 
-	std::string paddedRateString("error");
-	try {
-		NetSnapshots n;
-
-		/* pressed L5, switching network direction */
-		if(LCDKey == LCD_KEY_L5) {
-			if(_currentRate == NetDirection::NET_RX) {
-				_currentRate = NetDirection::NET_TX;
+	/* pressed L5, switching network direction */
+	if(LCDKey & toEnumType(Keys::GK_KEY_L5)) {
+		if(_currentRate == NetDirection::NET_RX) {
+			_currentRate = NetDirection::NET_TX;
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
-				GKLog2(trace, _plugin.getName(), " switched network rate to upload")
+			GKLog2(trace, _plugin.getName(), " switched network rate to upload")
 #endif
-			}
-			else {
-				_currentRate = NetDirection::NET_RX;
+		}
+		else {
+			_currentRate = NetDirection::NET_RX;
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
-				GKLog2(trace, _plugin.getName(), " switched network rate to download")
+			GKLog2(trace, _plugin.getName(), " switched network rate to download")
 #endif
-			}
 		}
-
-		const std::string rateString(n.getRateString(_currentRate));
-		paddedRateString = getPaddedRateString(rateString, _lastRateStringSize);
 	}
-	catch (const GLogiKExcept & e) {
-		paddedRateString = getPaddedRateString(paddedRateString, _lastRateStringSize);
-		GKLog2(error, "network calculations error : ", e.what());
+
+	std::string paddedRateString("error");
+	if( stats->netRatesValid ) {
+		const unsigned long long rate =
+			(_currentRate == NetDirection::NET_RX) ? stats->netRXRate : stats->netTXRate;
+		paddedRateString = NetSnapshots::getRateString(rate, _currentRate);
 	}
+	paddedRateString = getPaddedRateString(paddedRateString, _lastRateStringSize);
 
 	/* -- -- -- */
 	/* FontID::MONOSPACE85 char width is 5 pixels */
@@ -22,11 +22,10 @@
 #ifndef SRC_BIN_DAEMON_LCDPLUGINS_SYSTEM_MONITOR_HPP_
 #define SRC_BIN_DAEMON_LCDPLUGINS_SYSTEM_MONITOR_HPP_
 
-#include "cpu-stats/CPUSnapshot.h"
-
 #include "LCDPlugin.hpp"
 
 #include "netsnap/netSnapshots.hpp"
+#include "systemStatsSampler.hpp"
 
 namespace GLogiK
 {
@@ -42,14 +41,13 @@ class SystemMonitor
 
 		const PixelsData & getNextPBMFrame(
 			FontsManager* const pFonts,
-			const std::string & LCDKey,
+			const uint64_t LCDKey,
 			const bool lockedPlugin
 		);
 
 	protected:
 
 	private:
-		CPUSnapshot _snapshot1;
 		std::size_t _lastRateStringSize;
 		NetDirection _currentRate;
 
@@ -0,0 +1,410 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <cmath>
+#include <cfenv>
+
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include <utility>
+
+#include <config.h>
+
+#include "lib/utils/utils.hpp"
+
+#include "systemStatsSampler.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+std::mutex SystemStatsSampler::usersMutex;
+std::mutex SystemStatsSampler::samplerMutex;
+std::condition_variable SystemStatsSampler::samplerCondition;
+std::thread SystemStatsSampler::samplerThread;
+unsigned int SystemStatsSampler::samplerUsers = 0;
+bool SystemStatsSampler::samplerStop = false;
+bool SystemStatsSampler::hwmonAdded = false;
+bool SystemStatsSampler::samplerReady = false;
+std::atomic<uint16_t> SystemStatsSampler::samplingPeriod(SYSTEM_STATS_SAMPLING_PERIOD);
+
+std::map<std::string, unsigned int> SystemStatsSampler::hwmonDirectories;
+std::shared_ptr<const SystemStatsSnapshot> SystemStatsSampler::lastSnapshot =
+	std::make_shared<const SystemStatsSnapshot>();
+
+/* returns false when the sampling thread could not be spawned,
+ * ::stop() must only be called after a successful ::start() */
+const bool SystemStatsSampler::start(void)
+{
+	GK_LOG_FUNC
+
+	std::lock_guard<std::mutex> lock(SystemStatsSampler::usersMutex);
+
+	if( SystemStatsSampler::samplerUsers > 0 ) {
+		SystemStatsSampler::samplerUsers++;
+		return true;
+	}
+
+	GKLog(trace, "starting system stats sampler")
+
+	{
+		std::lock_guard<std::mutex> lock(SystemStatsSampler::samplerMutex);
+		SystemStatsSampler::samplerStop = false;
+		SystemStatsSampler::samplerReady = false;
+	}
+
+	try {
+		SystemStatsSampler::samplerThread = std::thread(&SystemStatsSampler::samplingLoop);
+	}
+	catch (const std::system_error& e) {
+		GKSysLogError("error while spawning system stats sampler thread : ", e.what());
+		return false;
+	}
+
+	SystemStatsSampler::samplerUsers++;
+
+	/* so that the first frames are not drawn from an empty snapshot */
+	{
+		std::unique_lock<std::mutex> lock(SystemStatsSampler::samplerMutex);
+		SystemStatsSampler::samplerCondition.wait_for(lock,
+			std::chrono::milliseconds(SYSTEM_STATS_SAMPLING_PERIOD_MIN),
+			[] { return SystemStatsSampler::samplerReady; }
+		);
+	}
+
+	return true;
+}
+
+/* usersMutex is held until the thread is joined, so that
+ * a concurrent ::start() can't resurrect the stopping loop */
+void SystemStatsSampler::stop(void)
+{
+	GK_LOG_FUNC
+
+	std::lock_guard<std::mutex> lock(SystemStatsSampler::usersMutex);
+
+	if( SystemStatsSampler::samplerUsers == 0 )
+		return;
+
+	if( --SystemStatsSampler::samplerUsers > 0 )
+		return;
+
+	GKLog(trace, "stopping system stats sampler")
+
+	{
+		std::lock_guard<std::mutex> lock(SystemStatsSampler::samplerMutex);
+		SystemStatsSampler::samplerStop = true;
+	}
+
+	SystemStatsSampler::samplerCondition.notify_all();
+
+	if( SystemStatsSampler::samplerThread.joinable() )
+		SystemStatsSampler::samplerThread.join();
+}
+
+/* used starting with the next sample */
+void SystemStatsSampler::setSamplingPeriod(const unsigned int period)
+{
+	const unsigned int p = std::clamp(
+		period,
+		static_cast<unsigned int>(SYSTEM_STATS_SAMPLING_PERIOD_MIN),
+		static_cast<unsigned int>(SYSTEM_STATS_SAMPLING_PERIOD_MAX)
+	);
+
+	if(p != period) {
+		std::ostringstream buffer(std::ios_base::app);
+		buffer << "system stats sampling period clamped to " << p << " ms";
+		GKSysLogWarning(buffer.str());
+	}
+
+	SystemStatsSampler::samplingPeriod = static_cast<uint16_t>(p);
+}
+
+/* called by coretemp plugins, the sampler is woken up
+ * so that the new sensors are read before the next frame */
+void SystemStatsSampler::addHwmonDirectory(const std::string & hwmonID)
+{
+	{
+		std::lock_guard<std::mutex> lock(SystemStatsSampler::samplerMutex);
+		if( SystemStatsSampler::hwmonDirectories[hwmonID]++ > 0 )
+			return;
+		SystemStatsSampler::hwmonAdded = true;
+	}
+
+	SystemStatsSampler::samplerCondition.notify_all();
+}
+
+void SystemStatsSampler::removeHwmonDirectory(const std::string & hwmonID)
+{
+	std::lock_guard<std::mutex> lock(SystemStatsSampler::samplerMutex);
+
+	auto it = SystemStatsSampler::hwmonDirectories.find(hwmonID);
+	if( it == SystemStatsSampler::hwmonDirectories.end() )
+		return;
+
+	if( --(it->second) == 0 )
+		SystemStatsSampler::hwmonDirectories.erase(it);
+}
+
+std::shared_ptr<const SystemStatsSnapshot> SystemStatsSampler::getSnapshot(void)
+{
+	return std::atomic_load(&SystemStatsSampler::lastSnapshot);
+}
+
+void SystemStatsSampler::samplingLoop(void)
+{
+	GK_LOG_FUNC
+
+	CPUSnapshot s1;
+	NetSnapshots net;
+
+	auto deadline = std::chrono::steady_clock::now();
+
+	while( true ) {
+		std::vector<std::string> hwmonIDs;
+
+		{
+			std::unique_lock<std::mutex> lock(SystemStatsSampler::samplerMutex);
+			SystemStatsSampler::samplerCondition.wait_until(lock, deadline,
+				[] { return (SystemStatsSampler::samplerStop or SystemStatsSampler::hwmonAdded); }
+			);
+
+			if( SystemStatsSampler::samplerStop )
+				break;
+
+			SystemStatsSampler::hwmonAdded = false;
+			for(const auto & hwmon : SystemStatsSampler::hwmonDirectories) {
+				hwmonIDs.push_back(hwmon.first);
+			}
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+		if( deadline <= now )
+			deadline = now + std::chrono::milliseconds( SystemStatsSampler::samplingPeriod.load() );
+
+		std::shared_ptr<SystemStatsSnapshot> snapshot;
+		try {
+			snapshot = std::make_shared<SystemStatsSnapshot>();
+		}
+		catch (const std::bad_alloc& e) { /* handle new() failure */
+			GKSysLogError("system stats snapshot allocation failure");
+			continue;
+		}
+
+		snapshot->usedMemory = SystemStatsSampler::getUsedMemory();
+
+		{
+			CPUSnapshot s2;
+			snapshot->CPUActiveTotal = SystemStatsSampler::getCPUActiveTotal(s1, s2);
+			s1 = s2;
+		}
+
+		try {
+			net.update();
+			snapshot->netRXRate = net.getRate(NetDirection::NET_RX);
+			snapshot->netTXRate = net.getRate(NetDirection::NET_TX);
+			snapshot->netRatesValid = true;
+		}
+		catch (const GLogiKExcept & e) {
+			GKLog2(error, "network calculations error : ", e.what());
+		}
+
+		for(const auto & hwmonID : hwmonIDs) {
+			try {
+				SystemStatsSampler::readHwmonSensors(hwmonID, snapshot->hwmon[hwmonID]);
+			}
+			catch (const GLogiKExcept & e) {
+				GKLog3(error, hwmonID, " sensors reading error : ", e.what())
+			}
+		}
+
+		std::atomic_store(
+			&SystemStatsSampler::lastSnapshot,
+			std::shared_ptr<const SystemStatsSnapshot>(std::move(snapshot))
+		);
+
+		{
+			std::lock_guard<std::mutex> lock(SystemStatsSampler::samplerMutex);
+			if( SystemStatsSampler::samplerReady )
+				continue;
+			SystemStatsSampler::samplerReady = true;
+		}
+		SystemStatsSampler::samplerCondition.notify_all();
+	}
+
+	/* readers still holding the last snapshot keep it alive */
+	std::atomic_store(
+		&SystemStatsSampler::lastSnapshot,
+		std::make_shared<const SystemStatsSnapshot>()
+	);
+}
+
+const uint16_t SystemStatsSampler::getUsedMemory(void)
+{
+	std::map<std::string, std::vector<std::string>> memShot;
+
+	uint64_t freePMem = 0;
+	uint64_t totalPMem = 1;
+
+	try {
+		std::ifstream meminfo("/proc/meminfo");
+		std::string line;
+		while( std::getline(meminfo, line) )
+		{
+			const char delim = ' ';
+			std::vector<std::string> words;
+			const std::vector<std::string> memItems = {"MemTotal", "MemFree", "MemAvailable", "Buffers", "Cached"};
+
+			std::stringstream ss(line);
+			std::string word;
+			while( std::getline(ss, word, delim) ) {
+				if( ! word.empty() )
+					words.push_back(word);
+			}
+
+			if( ! words.empty() ) {
+				for(const auto & item : memItems) {
+					const std::string & s = words[0];
+					if( s.substr(0, s.size()-1) == item ) {
+						memShot.insert( std::pair<std::string, std::vector<std::string>>(item, words));
+					}
+				}
+			}
+
+			if( memShot.size() == memItems.size() ) {
+				break;
+			}
+		}
+	}
+	catch (const std::ifstream::failure & e) {
+		GKSysLogError("error opening/reading/closing /proc/meminfo : ", e.what());
+		return 0;
+	}
+
+	try {
+		totalPMem = toULL( memShot.at("MemTotal").at(1) );
+
+		// Linux Kernel 3.14+
+		if( memShot.count("MemAvailable") == 1 ) {
+			freePMem  = toULL( memShot["MemAvailable"].at(1) );
+		}
+		else {
+			freePMem  = toULL( memShot.at("MemFree").at(1) );
+			freePMem += toULL( memShot.at("Buffers").at(1) );
+			freePMem += toULL( memShot.at("Cached").at(1) );
+		}
+	}
+	catch (const std::out_of_range& oor) {
+		GKSysLogWarning("meminfo parsing problem : ", oor.what());
+		freePMem = 0;
+	}
+	catch (const GLogiKExcept & e) {
+		GKSysLogWarning("meminfo conversion failure : ", e.what());
+		freePMem = 0;
+	}
+
+	if( totalPMem == 0 )
+		return 0;
+
+	float freeMem = 100 * freePMem / totalPMem;
+	std::fesetround(FE_TONEAREST);
+	freeMem = std::nearbyint(freeMem);
+
+	return (100 - static_cast<uint16_t>(freeMem));
+}
+
+const uint16_t SystemStatsSampler::getCPUActiveTotal(
+	const CPUSnapshot & s1,
+	const CPUSnapshot & s2)
+{
+	/* see cpu-stat - CPUStatsPrinter::GetPercActiveTotal() */
+	const float ACTIVE_TIME		= s2.GetActiveTimeTotal() - s1.GetActiveTimeTotal();
+	const float IDLE_TIME		= s2.GetIdleTimeTotal() - s1.GetIdleTimeTotal();
+	const float TOTAL_TIME		= ACTIVE_TIME + IDLE_TIME;
+
+	if( TOTAL_TIME <= 0.f )
+		return 0;
+
+	float cpuPercentTotal = 100.f * ACTIVE_TIME / TOTAL_TIME;
+
+	std::fesetround(FE_TONEAREST);
+	cpuPercentTotal = std::nearbyint(cpuPercentTotal);
+
+	return static_cast<uint16_t>(cpuPercentTotal);
+}
+
+void SystemStatsSampler::readHwmonSensors(
+	const std::string & hwmonID,
+	std::vector<HwmonSensor> & sensors)
+{
+	try {
+		unsigned short x = 1;
+
+		std::ifstream infile;
+		infile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+		while(true) {
+			std::string inputFile = hwmonID;
+			inputFile += "/temp";
+			inputFile += std::to_string(x);
+			inputFile += "_input";
+
+			std::string labelFile = hwmonID;
+			labelFile += "/temp";
+			labelFile += std::to_string(x);
+			labelFile += "_label";
+
+			HwmonSensor sensor;
+			std::string label;
+
+			infile.open(inputFile);
+			std::getline(infile, sensor.input);
+			infile.close();
+
+			infile.open(labelFile);
+			std::getline(infile, label);
+			infile.close();
+
+			sensor.isPkg = (label.substr(0, 11) == "Package id ") ? true : false;
+			sensor.id = (sensor.isPkg) ? label.substr(11) : label.substr(5);
+
+			sensors.push_back(sensor);
+
+			x++;
+		}
+	}
+	catch (const std::ifstream::failure & e) {
+		if( sensors.empty() ) {
+			GKSysLogError("error opening/reading/closing file : ", e.what());
+			throw GLogiKExcept("ifstream error");
+		}
+	}
+}
+
+} // namespace GLogiK
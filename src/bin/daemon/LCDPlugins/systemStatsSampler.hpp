@@ -0,0 +1,120 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SRC_BIN_DAEMON_LCDPLUGINS_SYSTEM_STATS_SAMPLER_HPP_
+#define SRC_BIN_DAEMON_LCDPLUGINS_SYSTEM_STATS_SAMPLER_HPP_
+
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <string>
+#include <vector>
+#include <map>
+
+#include "cpu-stats/CPUSnapshot.h"
+#include "netsnap/netSnapshots.hpp"
+
+/* default and bounds of the sampling period, in milliseconds */
+#define SYSTEM_STATS_SAMPLING_PERIOD 500
+#define SYSTEM_STATS_SAMPLING_PERIOD_MIN 100
+#define SYSTEM_STATS_SAMPLING_PERIOD_MAX 10000
+
+namespace GLogiK
+{
+
+struct HwmonSensor
+{
+	std::string id;
+	std::string input;	/* millidegrees Celsius */
+	bool isPkg;
+};
+
+/* immutable once published */
+struct SystemStatsSnapshot
+{
+	uint16_t CPUActiveTotal = 0;	/* percent */
+	uint16_t usedMemory = 0;		/* percent */
+	bool netRatesValid = false;
+	unsigned long long netRXRate = 0;	/* bytes per second */
+	unsigned long long netTXRate = 0;	/* bytes per second */
+	/* sensors by hwmon directory */
+	std::map<std::string, std::vector<HwmonSensor>> hwmon;
+};
+
+/*
+ * One sampling thread for the whole daemon, started by the first LCD
+ * screen thread which displays a system stats plugin and stopped with
+ * the last one. LCD plugins of every device read the last published
+ * snapshot without doing any I/O.
+ */
+class SystemStatsSampler
+{
+	public:
+		static const bool start(void);
+		static void stop(void);
+
+		static void setSamplingPeriod(const unsigned int period);
+
+		static void addHwmonDirectory(const std::string & hwmonID);
+		static void removeHwmonDirectory(const std::string & hwmonID);
+
+		static std::shared_ptr<const SystemStatsSnapshot> getSnapshot(void);
+
+	protected:
+
+	private:
+		SystemStatsSampler(void) = delete;
+
+		static std::mutex usersMutex;
+		static std::mutex samplerMutex;
+		static std::condition_variable samplerCondition;
+		static std::thread samplerThread;
+		static unsigned int samplerUsers;
+		static bool samplerStop;
+		static bool hwmonAdded;
+		static bool samplerReady;	/* first snapshot published */
+		static std::atomic<uint16_t> samplingPeriod;
+
+		/* registered hwmon directories, with their coretemp plugins count */
+		static std::map<std::string, unsigned int> hwmonDirectories;
+		static std::shared_ptr<const SystemStatsSnapshot> lastSnapshot;
+
+		static void samplingLoop(void);
+
+		static const uint16_t getUsedMemory(void);
+		static const uint16_t getCPUActiveTotal(
+			const CPUSnapshot & s1,
+			const CPUSnapshot & s2
+		);
+		static void readHwmonSensors(
+			const std::string & hwmonID,
+			std::vector<HwmonSensor> & sensors
+		);
+};
+
+} // namespace GLogiK
+
+#endif
@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <string>
+#include <sstream>
 #include <algorithm>
 #include <new>
 
@@ -46,8 +47,10 @@ const LCDPPArray_type LCDScreenPluginsManager::_LCDPluginsPropertiesEmptyArray =
 LCDScreenPluginsManager::LCDScreenPluginsManager(const std::string & product)
 	:	_pFonts(&_fontsManager),
 		_frameCounter(0),
+		_missedDeadlines(0),
 		_noPlugins(false),
-		_currentPluginLocked(false)
+		_currentPluginLocked(false),
+		_LCDBufferCleared(true)
 {
 	GK_LOG_FUNC
 
@@ -125,6 +128,20 @@ const uint16_t LCDScreenPluginsManager::getPluginTiming(void)
 	return 1000;
 }
 
+/* frames which could not be refreshed on time by the current plugin */
+void LCDScreenPluginsManager::reportMissedDeadlines(const uint64_t missed)
+{
+	GK_LOG_FUNC
+
+#if DEBUGGING_ON && DEBUG_LCD_PLUGINS
+	if(_itCurrentPlugin != _plugins.end() ) {
+		GKLog3(trace, (*_itCurrentPlugin)->getPluginName(), " missed frame deadlines : ", missed)
+	}
+#endif
+
+	_missedDeadlines += missed;
+}
+
 void LCDScreenPluginsManager::unlockPlugin(void)
 {
 	GK_LOG_FUNC
@@ -185,7 +202,7 @@ const bool LCDScreenPluginsManager::findOneLCDScreenPlugin(const uint64_t LCDPlu
 }
 
 const PixelsData & LCDScreenPluginsManager::getNextLCDScreenBuffer(
-	const std::string & LCDKey,
+	const uint64_t LCDKey,
 	const uint64_t LCDPluginsMask1)
 {
 	GK_LOG_FUNC
@@ -197,7 +214,7 @@ const PixelsData & LCDScreenPluginsManager::getNextLCDScreenBuffer(
 				_frameCounter++;
 
 				/* pressed locking key ? */
-				if(LCDKey == LCD_KEY_L2) {
+				if(LCDKey & toEnumType(Keys::GK_KEY_L2)) {
 					_currentPluginLocked = ! (_currentPluginLocked);
 #if DEBUGGING_ON
 					if( _currentPluginLocked ) {
@@ -210,6 +227,8 @@ const PixelsData & LCDScreenPluginsManager::getNextLCDScreenBuffer(
 				}
 
 				if( _frameCounter >= (*_itCurrentPlugin)->getPluginMaxFrames() ) {
+					this->logMissedDeadlines();
+
 					bool found = false;
 					const std::vector<LCDPlugin*>::const_iterator itFirstPlugin = _itCurrentPlugin;
 					while( ! found ) {
@@ -241,15 +260,23 @@ const PixelsData & LCDScreenPluginsManager::getNextLCDScreenBuffer(
 			}
 
 			if(_itCurrentPlugin != _plugins.end() ) {
-				(*_itCurrentPlugin)->prepareNextPBMFrame();
-				this->dumpPBMDataIntoLCDBuffer(
-					_LCDBuffer,
-					(*_itCurrentPlugin)->getNextPBMFrame(_pFonts, LCDKey, _currentPluginLocked)
-				);
+				LCDPlugin* const plugin = (*_itCurrentPlugin);
+
+				plugin->prepareNextPBMFrame();
+				if( _LCDBufferCleared )
+					plugin->damageWholePBMFrame();
+
+				const PixelsData & PBMData = plugin->getNextPBMFrame(_pFonts, LCDKey, _currentPluginLocked);
+
+				/* only the damaged regions of the PBM frame are transposed */
+				this->dumpPBMDataIntoLCDBuffer(_LCDBuffer, PBMData, plugin->getPBMFrameDamage());
+				plugin->clearPBMFrameDamage();
+				_LCDBufferCleared = false;
 			}
 			else {
 				/* blank screen */
 				std::fill(_LCDBuffer.begin(), _LCDBuffer.end(), 0x0);
+				_LCDBufferCleared = true;
 			}
 		}
 		catch (const GLogiKExcept & e) {
@@ -258,6 +285,7 @@ const PixelsData & LCDScreenPluginsManager::getNextLCDScreenBuffer(
 			GKLog(error, e.what())
 
 			std::fill(_LCDBuffer.begin(), _LCDBuffer.end(), 0x0);
+			_LCDBufferCleared = true;
 		}
 
 		std::fill_n(_LCDBuffer.begin(), LCD_DATA_HEADER_OFFSET, 0x0);
@@ -275,12 +303,30 @@ void LCDScreenPluginsManager::stopLCDPlugins(void)
 
 	GKLog(trace, "stopping LCD screen plugins")
 
+	this->logMissedDeadlines();
+
 	for(const auto & plugin : _plugins) {
 		delete plugin;
 	}
 	_plugins.clear();
 }
 
+/* one summary per plugin display period, to avoid flooding syslog */
+void LCDScreenPluginsManager::logMissedDeadlines(void)
+{
+	if( _missedDeadlines == 0 )
+		return;
+
+	if(_itCurrentPlugin != _plugins.end() ) {
+		std::ostringstream buffer(std::ios_base::app);
+		buffer	<< "LCD plugin " << (*_itCurrentPlugin)->getPluginName()
+				<< " missed " << _missedDeadlines << " frame deadlines";
+		GKSysLogWarning(buffer.str());
+	}
+
+	_missedDeadlines = 0;
+}
+
 /*
  * -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
  * PBM data binary format (without header), for a set of bytes (A, B, C, ...)
@@ -334,13 +380,28 @@ void LCDScreenPluginsManager::stopLCDPlugins(void)
  *	A1	<- only the first three bits are shown on the bottom row (the last three
  *	A2		pixels of the 43-pixel high display.)
  *
+ * -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+ * Each LCD 8-pixel-high row is built from one 8-rows band of the PBM data.
+ * Bands without damage, and PBM bytes columns without damage inside the
+ * other bands, keep the LCD bytes of the previous dump.
+ * -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
  */
-void LCDScreenPluginsManager::dumpPBMDataIntoLCDBuffer(PixelsData & LCDBuffer, const PixelsData & PBMData)
+void LCDScreenPluginsManager::dumpPBMDataIntoLCDBuffer(
+	PixelsData & LCDBuffer,
+	const PixelsData & PBMData,
+	const PBMDamage_type & PBMDamage)
 {
 	for(unsigned int row = 0; row < DEFAULT_PBM_HEIGHT_IN_BYTES; ++row) {
-		unsigned int LCDCol = 0;
+		const uint32_t damagedColumns = PBMDamage[row];
+		if( damagedColumns == 0 )
+			continue;
+
 		unsigned int rowOffset = (DEFAULT_PBM_WIDTH * row);
 		for(unsigned int PBMByte = 0; PBMByte < DEFAULT_PBM_WIDTH_IN_BYTES; ++PBMByte) {
+			if( (damagedColumns & (1u << PBMByte)) == 0 )
+				continue;
+
+			unsigned int LCDCol = (PBMByte * 8);
 
 			for(int bit = 7; bit > -1; --bit) {
 
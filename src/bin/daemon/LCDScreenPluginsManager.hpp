@@ -49,10 +49,11 @@ class LCDScreenPluginsManager
 		const bool findOneLCDScreenPlugin(const uint64_t LCDPluginsMask1) const;
 
 		const PixelsData & getNextLCDScreenBuffer(
-			const std::string & LCDKey,
+			const uint64_t LCDKey,
 			const uint64_t LCDPluginsMask1
 		);
 		const uint16_t getPluginTiming(void);
+		void reportMissedDeadlines(const uint64_t missed);
 
 		void unlockPlugin(void);
 		const uint64_t getCurrentPluginID(void);
@@ -71,11 +72,18 @@ class LCDScreenPluginsManager
 		FontsManager* const _pFonts;
 
 		uint16_t _frameCounter;
+		uint64_t _missedDeadlines;	/* by current plugin */
 		bool _noPlugins;
 		bool _currentPluginLocked;
+		bool _LCDBufferCleared;		/* next dump must be complete */
 
 		void stopLCDPlugins(void);
-		void dumpPBMDataIntoLCDBuffer(PixelsData & LCDBuffer, const PixelsData & PBMData);
+		void logMissedDeadlines(void);
+		void dumpPBMDataIntoLCDBuffer(
+			PixelsData & LCDBuffer,
+			const PixelsData & PBMData,
+			const PBMDamage_type & PBMDamage
+		);
 };
 
 } // namespace GLogiK
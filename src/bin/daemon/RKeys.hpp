@@ -0,0 +1,77 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_BIN_DAEMON_RKEYS_HPP_
+#define SRC_BIN_DAEMON_RKEYS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+
+#include <array>
+
+#include "include/enums.hpp"
+
+namespace GLogiK
+{
+
+/* RKey - Recognized Keys */
+struct RKey
+{
+	const Keys key;
+	const uint16_t index;
+	const unsigned char mask;
+};
+
+/* maps each value of one report byte to its recognized keys bitmask */
+typedef std::array<uint64_t, 256> RKeysByteTable;
+
+/* no utils dependency, this header is also used by tools/G510-decode-bench.cpp */
+template <std::size_t N>
+	constexpr uint64_t getRKeysMask(const std::array<RKey, N> & keys)
+{
+	uint64_t mask = 0;
+	for(const auto & key : keys)
+		mask |= static_cast<uint64_t>(key.key);
+	return mask;
+}
+
+template <std::size_t B, std::size_t N>
+	constexpr void fillRKeysByteTables(
+		std::array<RKeysByteTable, B> & tables,
+		const std::array<RKey, N> & keys)
+{
+	for(std::size_t value = 0; value < 256; ++value) {
+		for(const auto & key : keys) {
+			if(value & key.mask)
+				tables[key.index][value] |= static_cast<uint64_t>(key.key);
+		}
+	}
+}
+
+/* lowest recognized key set in mask, mask must not be zero */
+constexpr Keys getFirstRKey(const uint64_t mask)
+{
+	return static_cast<Keys>(one << __builtin_ctzll(mask));
+}
+
+} // namespace GLogiK
+
+#endif
@@ -38,7 +38,7 @@ enum class USBAPIKeysTransferStatus : int8_t
 	TRANSFER_ERROR = -1,
 #if GKLIBUSB
 	TRANSFER_TIMEOUT = LIBUSB_ERROR_TIMEOUT,
-#elif GKHIDAPI
+#elif GKHIDAPI || GKSIMUSB
 	TRANSFER_TIMEOUT = -7,
 #endif
 };
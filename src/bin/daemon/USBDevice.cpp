@@ -35,6 +35,8 @@ using namespace NSGKUtils;
 
 USBDevice::USBDevice(const USBDeviceID & device)
 		:	USBDeviceID(device),
+			_mediaKey(0),
+			_LCDKey(0),
 			_pressedRKeysMask(0),
 			_LCDPluginsMask1(0),
 			_pLCDPluginsManager(nullptr),
@@ -43,18 +45,23 @@ USBDevice::USBDevice(const USBDeviceID & device)
 			_pUSBDeviceHandle(nullptr),
 #elif GKHIDAPI
 			_pHIDDevice(nullptr),
+#elif GKSIMUSB
+			_pUSBDevice(nullptr),
+			_pSimDevice(nullptr),
 #endif
 			_MxKeysLedsMask(0),
 			_exitMacroRecordMode(false),
 			_threadsStatus(true),
 			_USBRequestsStatus(true),
+			_LCDKeysQueueHead(0),
+			_LCDKeysQueueTail(0),
 			_lastKeysInterruptTransferLength(0),
 			_lastLCDInterruptTransferLength(0),
 #if GKLIBUSB
 			_fatalErrors(0),
 			_keysEndpoint(0),
 			_LCDEndpoint(0),
-#elif GKHIDAPI
+#elif GKHIDAPI || GKSIMUSB
 			_fatalErrors(0),
 #endif
 			_GKeyID(GKeyID_INV) // invalid
@@ -65,81 +72,90 @@ USBDevice::USBDevice(const USBDeviceID & device)
 	_lastTimePoint = std::chrono::steady_clock::now();
 }
 
-void USBDevice::operator=(const USBDevice& dev)
+/* wakes up device threads waiting in ::waitForThreadsStop() */
+void USBDevice::stopThreads(void) noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock(_stopMutex);
+		_threadsStatus = false;
+	}
+	_stopCondition.notify_all();
+}
+
+/* allows device threads to be spawned again after ::stopThreads() */
+void USBDevice::restartThreads(void) noexcept
 {
-	_vendor			= dev._vendor;
-	_product		= dev._product;
-	_name			= dev._name;
-	_fullname		= dev._fullname;
-	_vendorID		= dev._vendorID;
-	_productID		= dev._productID;
-	_capabilities	= dev._capabilities;
-	_bus			= dev._bus;
-	_num			= dev._num;
-	_devID			= dev._devID;
-
-	_devnode		= dev._devnode;
-	_serial			= dev._serial;
-	_usec			= dev._usec;
-	_driverID		= dev._driverID;
-
-	/* USB_INTERFACE_DESCRIPTOR */
-	_bConfigurationValue	= dev._bConfigurationValue;
-	_bInterfaceNumber		= dev._bInterfaceNumber;
-	_bAlternateSetting		= dev._bAlternateSetting;
-	_bNumEndpoints			= dev._bNumEndpoints;
-
-	_keysInterruptBufferMaxLength	= dev._keysInterruptBufferMaxLength;
-	_GKeysTransferLength			= dev._GKeysTransferLength;
-	_MediaKeysTransferLength		= dev._MediaKeysTransferLength;
-	_LCDKeysTransferLength			= dev._LCDKeysTransferLength;
-
-	/* end friendship members */
-
-	/* public */
-	_fatalErrors					= dev._fatalErrors;
-	_keysThreadID					= dev._keysThreadID;
-	_LCDThreadID					= dev._LCDThreadID;
-	_pressedRKeysMask				= dev._pressedRKeysMask;
-	_MxKeysLedsMask					= static_cast<uint8_t>(dev._MxKeysLedsMask);
-	_exitMacroRecordMode			= static_cast<bool>(dev._exitMacroRecordMode);
-	_LCDPluginsMask1				= dev._LCDPluginsMask1;
-	std::copy(
-		std::begin(dev._pressedKeys),
-		std::end(dev._pressedKeys),
-		std::begin(_pressedKeys)
+	std::lock_guard<std::mutex> lock(_stopMutex);
+	_threadsStatus = true;
+	_fatalErrors = 0;
+	/* both threads are stopped, drop keys pressed before */
+	_LCDKeysQueueHead = 0;
+	_LCDKeysQueueTail = 0;
+	std::fill_n(_pressedKeys, KEYS_BUFFER_LENGTH, 0);
+	std::fill_n(_previousPressedKeys, KEYS_BUFFER_LENGTH, 0);
+	_lastTimePoint = std::chrono::steady_clock::now();
+}
+
+/* interruptible sleep, returns true if threads must stop */
+const bool USBDevice::waitForThreadsStop(const std::chrono::milliseconds & timeout)
+{
+	std::unique_lock<std::mutex> lock(_stopMutex);
+	return _stopCondition.wait_for(lock, timeout,
+		[this] () -> const bool { return ( ! _threadsStatus ); }
 	);
-	std::copy(
-		std::begin(dev._previousPressedKeys),
-		std::end(dev._previousPressedKeys),
-		std::begin(_previousPressedKeys)
+}
+
+/*
+ * interruptible sleep until an absolute deadline, used by the LCD screen
+ * thread, also woken up by ::pushLCDKey(), returns true if threads must stop
+ */
+const bool USBDevice::waitForLCDKeyOrThreadsStop(const std::chrono::steady_clock::time_point & deadline)
+{
+	std::unique_lock<std::mutex> lock(_stopMutex);
+	_stopCondition.wait_until(lock, deadline,
+		[this] () -> const bool {
+			return ( (! _threadsStatus) or
+				(_LCDKeysQueueHead.load(std::memory_order_relaxed) !=
+					_LCDKeysQueueTail.load(std::memory_order_relaxed)) );
+		}
 	);
-	_GKeyID				= dev._GKeyID;
-	_mediaKey			= dev._mediaKey;
-	_newMacro			= dev._newMacro;
-	_lastTimePoint		= dev._lastTimePoint;
+	return ( ! _threadsStatus );
+}
 
-	/* private */
-	_pLCDPluginsManager				= dev._pLCDPluginsManager;
+/* listening thread only, returns false if the queue is full */
+const bool USBDevice::pushLCDKey(const uint64_t key) noexcept
+{
+	const unsigned int tail = _LCDKeysQueueTail.load(std::memory_order_relaxed);
+	const unsigned int next = (tail + 1) % _LCDKeysQueueSize;
 
-	this->setRGBBytes(dev._RGB[0], dev._RGB[1], dev._RGB[2]);
-	_lastKeysInterruptTransferLength	= dev._lastKeysInterruptTransferLength;
-	_lastLCDInterruptTransferLength		= dev._lastLCDInterruptTransferLength;
-	_threadsStatus		= static_cast<bool>(dev._threadsStatus);
-	_USBRequestsStatus	= static_cast<bool>(dev._USBRequestsStatus);
+	if( next == _LCDKeysQueueHead.load(std::memory_order_acquire) )
+		return false;
 
-#if GKLIBUSB
-	_pUSBDevice			= dev._pUSBDevice;
-	_pUSBDeviceHandle	= dev._pUSBDeviceHandle;
+	_LCDKeysQueue[tail] = key;
+	_LCDKeysQueueTail.store(next, std::memory_order_release);
 
-	_keysEndpoint		= dev._keysEndpoint;
-	_LCDEndpoint		= dev._LCDEndpoint;
+	/* taking the mutex orders the push with a concurrent predicate check
+	 * in ::waitForLCDKeyOrThreadsStop(), so the wake up can't be missed */
+	{
+		std::lock_guard<std::mutex> lock(_stopMutex);
+	}
+	_stopCondition.notify_all();
 
-	_toRelease			= dev._toRelease;
-	_toAttach			= dev._toAttach;
-#elif GKHIDAPI
-	_pHIDDevice			= dev._pHIDDevice;
-#endif
+	return true;
+}
+
+/* LCD screen thread only, returns 0 if the queue is empty */
+const uint64_t USBDevice::popLCDKey(void) noexcept
+{
+	const unsigned int head = _LCDKeysQueueHead.load(std::memory_order_relaxed);
+
+	if( head == _LCDKeysQueueTail.load(std::memory_order_acquire) )
+		return 0;
+
+	const uint64_t key = _LCDKeysQueue[head];
+	_LCDKeysQueueHead.store((head + 1) % _LCDKeysQueueSize, std::memory_order_release);
+
+	return key;
 }
 
 void USBDevice::destroyLCDPluginsManager(void) noexcept
@@ -25,15 +25,18 @@
 #include <cstdint>
 
 #include <atomic>
+#include <array>
 #include <vector>
 #include <string>
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
 
 #include "LCDScreenPluginsManager.hpp"
 
 #include "USBDeviceID.hpp"
+#include "deviceMetrics.hpp"
 
 #include "include/base.hpp"
 
@@ -48,30 +51,38 @@
 namespace GLogiK
 {
 
+#if GKSIMUSB
+struct SimUSBDevice;
+#endif
+
 class USBDevice
 	:	public USBDeviceID
 {
 	public:
-		USBDevice(void) = default;
+		USBDevice(void) = delete;
 		~USBDevice(void) = default;
 
+		/* devices are created once on initialization, then never copied nor moved */
 		USBDevice(const USBDevice & dev) = delete;
 		USBDevice(const USBDeviceID & dev);
 
-		void operator=(const USBDevice& dev);
-
-		std::mutex					_LCDMutex;
+		USBDevice & operator=(const USBDevice& dev) = delete;
 
 #if GKLIBUSB
 	private:
 		friend class libusb;
 
 		std::mutex					_libUSBMutex;
+		/* in-flight interrupt transfers, cancelled on device stop */
+		std::mutex					_transfersMutex;
+		libusb_transfer*			_pKeysTransfer = nullptr;
+		libusb_transfer*			_pLCDTransfer = nullptr;
 #endif
 
 	public:
-		std::string					_mediaKey;
-		std::string					_LCDKey;
+		/* last pressed media and LCD keys, Keys bitmasks */
+		uint64_t					_mediaKey;
+		uint64_t					_LCDKey;
 
 		macro_type					_newMacro;
 
@@ -83,7 +94,7 @@ class USBDevice
 
 	public:
 		uint64_t					_pressedRKeysMask;
-		uint64_t					_LCDPluginsMask1;
+		std::atomic<uint64_t>		_LCDPluginsMask1;
 
 	private:
 		friend class USBInit;
@@ -98,6 +109,10 @@ class USBDevice
 		friend class hidapi;
 
 		hid_device*					_pHIDDevice;
+#elif GKSIMUSB
+		friend class simusb;
+
+		SimUSBDevice*				_pSimDevice;
 #endif
 
 	public:
@@ -107,13 +122,31 @@ class USBDevice
 		std::chrono::steady_clock::time_point
 									_lastTimePoint;
 
+		/* latency probes, see LatencyProbe, only set when enabled */
+		uint64_t					_reportTimestamp = 0;
+		uint64_t					_decodedTimestamp = 0;
+
+		DeviceMetrics				_metrics;
+
 		std::atomic<uint8_t>		_MxKeysLedsMask;
 		std::atomic<bool>			_exitMacroRecordMode;
 
 	private:
+		std::mutex					_stopMutex;
+		std::condition_variable		_stopCondition;
 		std::atomic<bool>			_threadsStatus;
 		std::atomic<bool>			_USBRequestsStatus;
 
+		/*
+		 * LCD keys pressed and not yet handled by the LCD screen thread.
+		 * Lock-free ring, the listening thread is the only producer and
+		 * the LCD screen thread the only consumer.
+		 */
+		static constexpr unsigned int _LCDKeysQueueSize = 16;
+		std::array<uint64_t, _LCDKeysQueueSize>	_LCDKeysQueue;
+		std::atomic<unsigned int>	_LCDKeysQueueHead;	/* next key to pop */
+		std::atomic<unsigned int>	_LCDKeysQueueTail;	/* next free slot */
+
 		int							_lastKeysInterruptTransferLength;
 		int							_lastLCDInterruptTransferLength;
 
@@ -149,7 +182,13 @@ class USBDevice
 		const int getLastLCDInterruptTransferLength(void) const { return _lastLCDInterruptTransferLength; }
 		/* -- -- -- */
 
-		void stopThreads(void) noexcept { _threadsStatus = false; }
+		void stopThreads(void) noexcept;
+		void restartThreads(void) noexcept;
+		const bool waitForThreadsStop(const std::chrono::milliseconds & timeout);
+		const bool waitForLCDKeyOrThreadsStop(const std::chrono::steady_clock::time_point & deadline);
+
+		const bool pushLCDKey(const uint64_t key) noexcept;
+		const uint64_t popLCDKey(void) noexcept;
 		void skipUSBRequests(void) noexcept { _USBRequestsStatus = false; }
 
 		void setRGBBytes(const uint8_t r, const uint8_t g, const uint8_t b);
@@ -107,8 +107,12 @@ class USBDeviceID
 			const uint8_t num
 		);
 		USBDeviceID(const USBDeviceID & device) = default;
+		USBDeviceID(USBDeviceID && device) = default;
 		~USBDeviceID(void) = default;
 
+		USBDeviceID & operator=(const USBDeviceID & device) = default;
+		USBDeviceID & operator=(USBDeviceID && device) = default;
+
 	protected:
 
 	private:
@@ -35,7 +35,7 @@ using namespace NSGKUtils;
 Client::Client(
 	const std::string & objectPath,
 	DevicesManager* const pDevicesManager)
-	:	_sessionState("unknown"),
+	:	_sessionState(SessionState::SESSION_UNKNOWN),
 		_sessionObjectPath(objectPath),
 		_check(true),
 		_ready(false)
@@ -59,12 +59,12 @@ const std::string & Client::getSessionObjectPath(void) const
 	return _sessionObjectPath;
 }
 
-const std::string & Client::getSessionCurrentState(void) const
+const SessionState Client::getSessionCurrentState(void) const
 {
 	return _sessionState;
 }
 
-void Client::updateSessionState(const std::string & newState)
+void Client::updateSessionState(const SessionState newState)
 {
 	_sessionState = newState;
 	_check = true;
@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 
+#include "lib/shared/glogik.hpp"
 #include "lib/shared/deviceProperties.hpp"
 
 #include "devicesManager.hpp"
@@ -44,8 +45,8 @@ class Client
 		~Client(void);
 
 		const std::string & getSessionObjectPath(void) const;
-		const std::string & getSessionCurrentState(void) const;
-		void updateSessionState(const std::string & newState);
+		const SessionState getSessionCurrentState(void) const;
+		void updateSessionState(const SessionState newState);
 		void uncheck(void);
 		const bool isAlive(void) const;
 		const bool isReady(void) const;
@@ -78,7 +79,7 @@ class Client
 	protected:
 
 	private:
-		std::string _sessionState;
+		SessionState _sessionState;
 		const std::string _sessionObjectPath;
 		std::map<std::string, clientDevice> _devices;
 		bool _check;
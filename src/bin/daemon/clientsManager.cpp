@@ -43,7 +43,6 @@ ClientsManager::ClientsManager(
 )	:	_pDBus(pDBus),
 		_pDevicesManager(pDevicesManager),
 		_pDepsMap(pDepsMap),
-		_active("active"),
 		_numActive(0),
 		_enabledSignals(true)
 {
@@ -192,6 +191,13 @@ void ClientsManager::initializeDBusRequests(void)
 			{"a(tss)", "get_lcd_plugins_properties_array", dOUT, "LCDPluginsProperties array"} },
 		std::bind(&ClientsManager::getDeviceLCDPluginsProperties, this, std::placeholders::_1, std::placeholders::_2) );
 
+	_pDBus->NSGKDBus::Callback<SIGss2as>::exposeMethod(
+		_systemBus, DM_OP, DM_IF, "GetDeviceMetrics",
+		{	{"s", "client_unique_id", dIN, "must be a valid client ID"},
+			{"s", "device_id", dIN, "device ID coming from GetStartedDevices or GetStoppedDevices"},
+			{"as", "array_of_strings", dOUT, "array of name=value device metrics strings"} },
+		std::bind(&ClientsManager::getDeviceMetrics, this, std::placeholders::_1, std::placeholders::_2) );
+
 	_pDBus->NSGKDBus::Callback<SIGss2aG>::exposeMethod(
 		_systemBus, DM_OP, DM_IF, "GetDeviceGKeysIDArray",
 		{	{"s", "client_unique_id", dIN, "must be a valid client ID"},
@@ -423,7 +429,7 @@ const bool ClientsManager::unregisterClient(
 		GKSysLogInfo(buffer.str());
 
 		/* resetting devices states first */
-		if( pClient->getSessionCurrentState() == _active ) {
+		if( pClient->getSessionCurrentState() == SessionState::SESSION_ACTIVE ) {
 			_pDevicesManager->resetDevicesStates();
 			GKLog2(trace, "decreasing active users # : ", _numActive)
 			_numActive--;
@@ -452,7 +458,10 @@ const bool ClientsManager::updateClientState(
 		"state : ", state
 	)
 
-	if( (state != _active) and (state != "online") ) {
+	/* state string converted only once, clients store enum values */
+	const SessionState newState = toSessionState(state);
+
+	if( (newState != SessionState::SESSION_ACTIVE) and (newState != SessionState::SESSION_ONLINE) ) {
 		std::ostringstream buffer(std::ios_base::app);
 		buffer << "unhandled state for updating devices : " << state;
 		GKSysLogWarning(buffer.str());
@@ -461,16 +470,16 @@ const bool ClientsManager::updateClientState(
 
 	try {
 		Client* pClient = _connectedClients.at(clientID);
-		const std::string oldState( pClient->getSessionCurrentState() );
-		pClient->updateSessionState(state);
+		const SessionState oldState = pClient->getSessionCurrentState();
+		pClient->updateSessionState(newState);
 
-		if( (oldState == _active) and (state != _active) ) {
+		if( (oldState == SessionState::SESSION_ACTIVE) and (newState != SessionState::SESSION_ACTIVE) ) {
 			GKLog2(trace, "decreasing active users # : ", _numActive)
 			_numActive--;
 		}
 
-		if(state == _active) {
-			if(oldState != _active) {
+		if(newState == SessionState::SESSION_ACTIVE) {
+			if(oldState != SessionState::SESSION_ACTIVE) {
 				GKLog2(trace, "increasing active users # : ", _numActive)
 				_numActive++;
 			}
@@ -505,7 +514,7 @@ const bool ClientsManager::toggleClientReadyPropertie(const std::string & client
 		Client* pClient = _connectedClients.at(clientID);
 		pClient->toggleClientReadyPropertie();
 		if( pClient->isReady() ) {
-			if(pClient->getSessionCurrentState() == _active) {
+			if(pClient->getSessionCurrentState() == SessionState::SESSION_ACTIVE) {
 				GKLog(trace, "setting active user's parameters for all started devices")
 				for(const auto & devID : _pDevicesManager->getStartedDevices()) {
 					pClient->setDeviceActiveUser(devID, _pDevicesManager);
@@ -585,7 +594,7 @@ const bool ClientsManager::stopDevice(
 			return false;
 		}
 
-		if(pClient->getSessionCurrentState() != _active) {
+		if(pClient->getSessionCurrentState() != SessionState::SESSION_ACTIVE) {
 			GKSysLogWarning("only active user can change device state");
 			return false;
 		}
@@ -627,7 +636,7 @@ const bool ClientsManager::startDevice(
 			return false;
 		}
 
-		if(pClient->getSessionCurrentState() != _active) {
+		if(pClient->getSessionCurrentState() != SessionState::SESSION_ACTIVE) {
 			GKSysLogWarning("only active user can change device state");
 			return false;
 		}
@@ -811,6 +820,32 @@ const LCDPPArray_type & ClientsManager::getDeviceLCDPluginsProperties(
 	return LCDScreenPluginsManager::_LCDPluginsPropertiesEmptyArray;
 }
 
+const std::vector<std::string> ClientsManager::getDeviceMetrics(
+		const std::string & clientID,
+		const std::string & devID)
+{
+	GK_LOG_FUNC
+
+	GKLog4(trace,
+		CONST_STRING_DEVICE, devID,
+		CONST_STRING_CLIENT, clientID
+	)
+
+	try {
+		Client* pClient = _connectedClients.at(clientID);
+		if( pClient->isAlive() ) {
+			return _pDevicesManager->getDeviceMetrics(devID);
+		}
+		GKSysLogWarning("getting device metrics not allowed because client not alive");
+	}
+	catch (const std::out_of_range& oor) {
+		GKSysLogError(CONST_STRING_UNKNOWN_CLIENT, clientID);
+	}
+
+	const std::vector<std::string> ret;
+	return ret;
+}
+
 const bool ClientsManager::setDeviceBacklightColor(
 	const std::string & clientID,
 	const std::string & devID,
@@ -65,7 +65,6 @@ class ClientsManager
 		DevicesManager* const _pDevicesManager;
 		const GKDepsMap_type* const _pDepsMap;
 
-		const std::string _active;
 		std::map<std::string, Client*> _connectedClients;
 
 		/* internal counter of active clients used
@@ -139,6 +138,10 @@ class ClientsManager
 			const std::string & clientID,
 			const std::string & devID
 		);
+		const std::vector<std::string> getDeviceMetrics(
+			const std::string & clientID,
+			const std::string & devID
+		);
 		const MKeysIDArray_type getDeviceMKeysIDArray(
 			const std::string & clientID,
 			const std::string & devID
@@ -36,6 +36,7 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <future>
 
 #include <boost/version.hpp>
 #include <boost/filesystem.hpp>
@@ -51,9 +52,13 @@
 
 #if GKHIDAPI
 #include "hidapi.hpp"
+#elif GKSIMUSB
+#include "simusb.hpp"
 #endif
 
 #include "devicesManager.hpp"
+#include "startupTimeline.hpp"
+#include "LCDPlugins/systemStatsSampler.hpp"
 
 #if GKDBUS
 #include "lib/dbus/GKDBus.hpp"
@@ -83,18 +88,28 @@ GLogiKDaemon::GLogiKDaemon(const int& argc, char *argv[])
 	/* -- -- -- */
 
 	try {
-		/* boost::po may throw */
-		this->parseCommandLine(argc, argv);
+		{
+			StartupTimeline::Phase phase("command line parsing");
+			/* boost::po may throw */
+			this->parseCommandLine(argc, argv);
+		}
 
 		if( GLogiKDaemon::isDaemonRunning() ) {
-			_pid = /*NSGKUtils::*/process::deamonize();
+			{
+				StartupTimeline::Phase phase("daemonize");
+				_pid = /*NSGKUtils::*/process::deamonize();
+			}
 			syslog(LOG_INFO, "process successfully daemonized");
 
+			StartupTimeline::Phase phase("PID file creation");
 			/* create PID file before dropping privileges */
 			this->createPIDFile();
 		}
 
-		this->dropPrivileges();
+		{
+			StartupTimeline::Phase phase("privileges drop");
+			this->dropPrivileges();
+		}
 
 		/* initialize logging */
 		/* -- -- -- */
@@ -112,11 +127,20 @@ GLogiKDaemon::GLogiKDaemon(const int& argc, char *argv[])
 
 		GKSysLogInfo("successfully dropped root privileges");
 
+		/* created with dropped privileges, written on exit */
+		if( ! _latencyFile.empty() ) {
+			LatencyProbe::open(_latencyFile);
+		}
+		if( ! _traceFile.empty() ) {
+			GKTrace::enable(_traceFile);
+		}
+
 		if( GLogiKDaemon::isDaemonRunning() ) {
 			GKLog2(info, "created PID file : ", _pidFileName)
 
 			process::setSignalHandler( SIGINT, GLogiKDaemon::handleSignal);
 			process::setSignalHandler(SIGTERM, GLogiKDaemon::handleSignal);
+			process::setSignalHandler(SIGUSR2, GLogiKDaemon::handleSignal);
 			// TODO SIGHUP ?
 		}
 	}
@@ -143,6 +167,14 @@ int GLogiKDaemon::run(void)
 
 	/* -- -- -- */
 
+	/* udevadm is run in a child process, don't wait for it */
+	std::future<std::string> libudevVersion = std::async(std::launch::async,
+		[] () -> std::string {
+			StartupTimeline::Phase phase("libudev version");
+			return DevicesManager::getLibudevVersion();
+		}
+	);
+
 	GKDepsMap_type dependencies;
 
 	std::string binaryVersion(GLOGIKD_DAEMON_NAME);
@@ -150,7 +182,7 @@ int GLogiKDaemon::run(void)
 	binaryVersion += VERSION;
 	GKSysLogInfo(binaryVersion);
 
-	{
+	auto setDependencies = [&dependencies, &libudevVersion] () -> void {
 		std::string boost_version;
 		{
 			int major = BOOST_VERSION / 100000;
@@ -167,7 +199,7 @@ int GLogiKDaemon::run(void)
 		dependencies[GKBinary::GK_DAEMON] =
 			{
 				{"boost", boost_version},
-				{"libudev", GK_DEP_LIBUDEV_VERSION_STRING, DevicesManager::getLibudevVersion()},
+				{"libudev", GK_DEP_LIBUDEV_VERSION_STRING, libudevVersion.get()},
 				{"libusb", GK_DEP_LIBUSB_VERSION_STRING, USBInit::getLibUSBVersion()},
 #if GKHIDAPI
 				{"hidapi", GK_DEP_LIBHIDAPI_VERSION_STRING, hidapi::getHIDAPIVersion()},
@@ -180,25 +212,52 @@ int GLogiKDaemon::run(void)
 				{"DBus", "-"},
 #endif
 			};
-	}
+	};
 
 	if( GLogiKDaemon::isDaemonRunning() ) {
 #if GKDBUS
 		NSGKDBus::GKDBus DBus(GLOGIK_DAEMON_DBUS_ROOT_NODE_PATH);
-		DBus.init();
-		DBus.connectToSystemBus(GLOGIK_DAEMON_DBUS_BUS_CONNECTION_NAME, NSGKDBus::ConnectionFlag::GKDBUS_SINGLE);
+		{
+			StartupTimeline::Phase phase("D-Bus connection");
+			DBus.init();
+			DBus.connectToSystemBus(GLOGIK_DAEMON_DBUS_BUS_CONNECTION_NAME, NSGKDBus::ConnectionFlag::GKDBUS_SINGLE);
+		}
 #endif
 
 		DevicesManager devicesManager;
 
 #if GKDBUS
 		devicesManager.setDBus(&DBus);
-		this->startSleepInhibition(&DBus, &devicesManager);
+#endif
 
+		/* udev setup and devices opening don't need D-Bus, run them
+		 * while registering on the bus, the future waits on destruction */
+		std::future<void> devicesStartup = std::async(std::launch::async,
+			[&devicesManager] () -> void {
+				StartupTimeline::Phase phase("devices startup");
+				devicesManager.initializeMonitoring();
+			}
+		);
+
+#if GKDBUS
+		{
+			StartupTimeline::Phase phase("sleep inhibition");
+			this->startSleepInhibition(&DBus, &devicesManager);
+		}
+
+		StartupTimeline::Phase clientsPhase("D-Bus requests registration");
 		ClientsManager clientsManager(&DBus, &devicesManager, &dependencies);
+		clientsPhase.stop();
 #endif
 
+		setDependencies();
+
 		try {
+			/* rethrows initialization failure */
+			devicesStartup.get();
+
+			StartupTimeline::finish(_startupTraceFile);
+
 			/* potential D-Bus requests received from services will be
 			 * handled after devices initialization into startMonitoring() */
 			devicesManager.startMonitoring();
@@ -227,6 +286,8 @@ int GLogiKDaemon::run(void)
 	else { // non-daemon mode
 		GKSysLogInfo("non-daemon mode");
 
+		setDependencies();
+
 		if(_version) {
 			printVersionDeps(binaryVersion, dependencies);
 		}
@@ -249,6 +310,10 @@ void GLogiKDaemon::handleSignal(int signum) {
 
 			GLogiKDaemon::exitDaemon();
 			break;
+		case SIGUSR2:
+			/* exported from the devices monitoring loop */
+			GKTrace::requestDump();
+			break;
 		default:
 			GKSysLogWarning( process::getSignalHandlingDesc(signum, " --> unhandled") );
 			break;
@@ -318,8 +383,18 @@ void GLogiKDaemon::parseCommandLine(const int& argc, char *argv[])
 		("daemonize,d", po::bool_switch()->default_value(false), "run in daemon mode")
 		("pid-file,p", po::value(&_pidFileName), "define the PID file")
 		("version,v", po::bool_switch()->default_value(false), "print some versions informations and exit")
+		("startup-trace,T", po::value(&_startupTraceFile), "write the startup timeline to this trace-event JSON file")
+		("latency-file,L", po::value(&_latencyFile), "record key events latency probes to this file")
+		("trace-file,t", po::value(&_traceFile), "enable hot-path tracing, exported to this trace-event JSON file on exit or SIGUSR2")
+		("stats-period,s", po::value<unsigned int>(), "LCD plugins system stats sampling period, in milliseconds")
 	;
 
+#if GKSIMUSB
+	desc.add_options()
+		("usb-simulator-script,S", po::value<std::string>(), "USB simulator script to replay")
+	;
+#endif
+
 #if DEBUGGING_ON
 	desc.add_options()
 		("debug,D", po::bool_switch()->default_value(false), "run in debug mode")
@@ -359,6 +434,17 @@ void GLogiKDaemon::parseCommandLine(const int& argc, char *argv[])
 		GKLogging::GKDebug = true;
 	}
 #endif
+
+	if( vm.count("stats-period") ) {
+		SystemStatsSampler::setSamplingPeriod( vm["stats-period"].as<unsigned int>() );
+	}
+
+#if GKSIMUSB
+	/* no script, simulated devices never send any report */
+	if( vm.count("usb-simulator-script") ) {
+		simusb::loadScript( vm["usb-simulator-script"].as<std::string>() ); /* throws on failure */
+	}
+#endif
 }
 
 void GLogiKDaemon::dropPrivileges(void) {
@@ -54,6 +54,9 @@ class GLogiKDaemon
 	protected:
 	private:
 		std::string _pidFileName;
+		std::string _startupTraceFile;
+		std::string _latencyFile;
+		std::string _traceFile;
 		pid_t _pid = 0;
 		bool _version;
 		bool _PIDFileCreated;
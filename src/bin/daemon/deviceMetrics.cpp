@@ -0,0 +1,93 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <sstream>
+#include <iomanip>
+
+#include "deviceMetrics.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+DeviceMetrics::DeviceMetrics(void)
+	:	keysTransfersOk(0),
+		keysTransfersTimeout(0),
+		keysTransfersError(0),
+		keysReports(0),
+		signalsEmitted(0),
+		LCDFramesRendered(0),
+		LCDFramesPushed(0),
+		LCDFramesSkipped(0),
+		LCDMissedDeadlines(0),
+		keysThreadWakeups(0),
+		LCDThreadWakeups(0),
+		fatalErrors(0),
+		_start(std::chrono::steady_clock::now())
+{
+}
+
+const std::vector<std::string> DeviceMetrics::toStrings(void) const
+{
+	std::vector<std::string> ret;
+
+	auto add = [&ret] (const char* name, const uint64_t value) -> void {
+		ret.push_back(std::string(name) + "=" + std::to_string(value));
+	};
+
+	const auto uptime = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - _start);
+	const double seconds = (uptime.count() > 0) ? (uptime.count() / 1000.0) : 1.0;
+
+	auto rate = [&ret, &seconds] (const char* name, const uint64_t value) -> void {
+		std::ostringstream buffer(std::ios_base::app);
+		buffer << name << "=" << std::fixed << std::setprecision(2) << (value / seconds);
+		ret.push_back(buffer.str());
+	};
+
+	add("uptime_ms", uptime.count());
+
+	add("usb.keys_transfers.ok", keysTransfersOk);
+	add("usb.keys_transfers.timeout", keysTransfersTimeout);
+	add("usb.keys_transfers.error", keysTransfersError);
+	add("keys.reports", keysReports);
+	add("dbus.signals_emitted", signalsEmitted);
+
+	add("lcd.frames.rendered", LCDFramesRendered);
+	add("lcd.frames.pushed", LCDFramesPushed);
+	add("lcd.frames.skipped", LCDFramesSkipped);
+	add("lcd.frames.missed_deadlines", LCDMissedDeadlines);
+	LCDRenderTime.appendTo(ret, "lcd.render_time");
+	LCDTransferTime.appendTo(ret, "lcd.transfer_time");
+
+	add("threads.keys.wakeups", keysThreadWakeups);
+	rate("threads.keys.wakeups_per_sec", keysThreadWakeups);
+	add("threads.lcd.wakeups", LCDThreadWakeups);
+	rate("threads.lcd.wakeups_per_sec", LCDThreadWakeups);
+
+	add("fatal_errors", fatalErrors);
+
+	return ret;
+}
+
+} // namespace GLogiK
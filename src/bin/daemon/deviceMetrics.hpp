@@ -0,0 +1,86 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SRC_BIN_DAEMON_DEVICE_METRICS_HPP_
+#define SRC_BIN_DAEMON_DEVICE_METRICS_HPP_
+
+#include <cstdint>
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <chrono>
+
+#include "lib/utils/utils.hpp"
+
+namespace GLogiK
+{
+
+/*
+ * Per-device runtime counters, updated lock-free from the device
+ * threads and read on GetDeviceMetrics D-Bus requests. Counters
+ * are kept for the whole device lifetime, from initialization to
+ * close, and survive suspend/resume.
+ */
+struct DeviceMetrics
+{
+	public:
+		DeviceMetrics(void);
+		~DeviceMetrics(void) = default;
+
+		DeviceMetrics(const DeviceMetrics &) = delete;
+		DeviceMetrics & operator=(const DeviceMetrics &) = delete;
+
+		/* keys interrupt transfers */
+		std::atomic<uint64_t>		keysTransfersOk;
+		std::atomic<uint64_t>		keysTransfersTimeout;
+		std::atomic<uint64_t>		keysTransfersError;
+		/* decoded keys reports */
+		std::atomic<uint64_t>		keysReports;
+		/* keys events D-Bus signals */
+		std::atomic<uint64_t>		signalsEmitted;
+
+		/* LCD screen frames */
+		std::atomic<uint64_t>		LCDFramesRendered;
+		std::atomic<uint64_t>		LCDFramesPushed;
+		std::atomic<uint64_t>		LCDFramesSkipped;
+		std::atomic<uint64_t>		LCDMissedDeadlines;
+
+		/* threads loops iterations */
+		std::atomic<uint64_t>		keysThreadWakeups;
+		std::atomic<uint64_t>		LCDThreadWakeups;
+
+		std::atomic<uint64_t>		fatalErrors;
+
+		NSGKUtils::MetricsHistogram	LCDRenderTime;
+		NSGKUtils::MetricsHistogram	LCDTransferTime;
+
+		/* name=value strings */
+		const std::vector<std::string> toStrings(void) const;
+
+	private:
+		const std::chrono::steady_clock::time_point _start;
+};
+
+} // namespace GLogiK
+
+#endif
@@ -27,8 +27,13 @@
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <atomic>
+#include <algorithm>
+#include <system_error>
+#include <utility>
 
 #include <poll.h>
+#include <sys/eventfd.h>
 #include <libudev.h>
 
 #include <boost/process.hpp>
@@ -40,6 +45,7 @@
 #include "devicesManager.hpp"
 
 #include "daemonControl.hpp"
+#include "startupTimeline.hpp"
 #include "logitechG510.hpp"
 
 #include "devicesManager.hpp"
@@ -48,6 +54,8 @@
 #include "libusb.hpp"
 #elif GKHIDAPI
 #include "hidapi.hpp"
+#elif GKSIMUSB
+#include "simusb.hpp"
 #endif
 
 #include "include/enums.hpp"
@@ -62,11 +70,17 @@ using namespace NSGKUtils;
 #if GKDBUS
 DevicesManager::DevicesManager()
 	:	_unknown("unknown"),
+		_devicesEventFD(-1),
+		_pUdev(nullptr),
+		_pMonitor(nullptr),
 		_pDBus(nullptr),
 		_numClients(0)
 #else
 DevicesManager::DevicesManager()
-	:	_unknown("unknown")
+	:	_unknown("unknown"),
+		_devicesEventFD(-1),
+		_pUdev(nullptr),
+		_pMonitor(nullptr)
 #endif
 {
 	GK_LOG_FUNC
@@ -82,7 +96,7 @@ DevicesManager::~DevicesManager()
 
 	this->stopInitializedDevices();
 	_sleepingDevices.clear();
-	_stoppedDevices.clear();
+	_devices.clear();
 
 	GKLog(trace, "stopping drivers")
 	for(const auto & driver : _drivers) {
@@ -90,6 +104,21 @@ DevicesManager::~DevicesManager()
 	}
 	_drivers.clear();
 
+	if(_devicesEventFD >= 0) {
+		close(_devicesEventFD);
+		_devicesEventFD = -1;
+	}
+
+	if(_pMonitor != nullptr) {
+		udev_monitor_unref(_pMonitor);
+		_pMonitor = nullptr;
+	}
+
+	if(_pUdev != nullptr) {
+		udev_unref(_pUdev);
+		_pUdev = nullptr;
+	}
+
 	GKLog(trace, "exiting devices manager")
 }
 
@@ -162,70 +191,74 @@ void DevicesManager::initializeDevices(const bool openDevices) noexcept
 	GKLog(trace, "initializing detected devices")
 
 	std::vector<std::string> initializedDevices;
+	DevicesJobs_type jobs;
 
-	for(const auto & devicePair : _detectedDevices)
-	{
-		const auto & devID = devicePair.first;
-		const auto & device = devicePair.second;
+	for(const auto & handle : _devices.getDevices(DeviceState::DEVICE_DETECTED)) {
+		DeviceEntry & entry = _devices.getDevice(handle);
 
-		if(_startedDevices.count(devID) == 1) {
-#if DEBUGGING_ON
-			if(GKLogging::GKDebug) {
-				LOG(trace)	<< "device already started : "
-							<< device.getVendorID() << ":"
-							<< device.getProductID() << " - "
-							<< device.getDevnode();
-			}
-#endif
-			continue; // jump to next detected device
+		/* initialization is done sequentially, only
+		 * the devices opening is run on the workers */
+		try {
+			entry.pDriver->initializeDevice( entry.device );
+			jobs.push_back( {&entry, true, ""} );
 		}
-
-		// TODO option ?
-		if(_stoppedDevices.count(devID) == 1) {
-#if DEBUGGING_ON
-			if(GKLogging::GKDebug) {
-				LOG(trace)	<< "device already initialized, but is in stopped state : "
-							<< device.getVendorID() << ":"
-							<< device.getProductID() << " - "
-							<< device.getDevnode();
-				LOG(trace)	<< "automatic initialization is disabled for stopped devices";
-			}
-#endif
-			continue; // jump to next detected device
+		catch ( const GLogiKExcept & e ) {
+			jobs.push_back( {&entry, false, e.what()} );
 		}
+		catch ( const std::exception & e ) {
+			jobs.push_back( {&entry, false, e.what()} );
+		}
+	}
 
-		for(const auto & driver : _drivers) {
-			if( device.getDriverID() == driver->getDriverID() ) {
-				std::ostringstream buffer(std::ios_base::app);
-				buffer	<< device.getFullName() << " "
-						<< device.getVendorID() << ":" << device.getProductID()
-						<< " on bus " << toUInt(device.getBus());
+	if(openDevices) {
+		this->runDevicesJobs(jobs,
+			[] (DeviceJob & job) -> void {
+				/* initialization failure */
+				if( ! job.success )
+					return;
 
+				StartupTimeline::Phase phase("open device " + job.pEntry->device.getID());
 				try {
-					// initialization
-					driver->initializeDevice( device );
-
-					if(openDevices) {
-						driver->openDevice( device ); /* throws GLogiKExcept on any failure */
-						_startedDevices[devID] = device;
-						buffer << " initialized (started)";
-					}
-					else {
-						_stoppedDevices[devID] = device;
-						buffer << " initialized (stopped)";
-					}
-					initializedDevices.push_back(devID);
+					job.pEntry->pDriver->openDevice( job.pEntry->device ); /* throws GLogiKExcept on any failure */
 				}
 				catch ( const GLogiKExcept & e ) {
-					buffer << " NOT initialized (failed)";
-					GKSysLogError("device initialization failure : ", e.what());
+					job.success = false;
+					job.error = e.what();
 				}
-
-				GKSysLogInfo(buffer.str());
-				break;
 			}
-		} // for : _drivers
-	} // for : _detectedDevices
+		);
+	}
+
+	for(const auto & job : jobs) {
+		DeviceEntry & entry = *(job.pEntry);
+		const auto & device = entry.device;
+
+		std::ostringstream buffer(std::ios_base::app);
+		buffer	<< device.getFullName() << " "
+				<< device.getVendorID() << ":" << device.getProductID()
+				<< " on bus " << toUInt(device.getBus());
+
+		if( ! job.success ) {
+			buffer << " NOT initialized (failed)";
+			GKSysLogError("device initialization failure : ", job.error);
+			GKSysLogInfo(buffer.str());
+			_devices.removeDevice(entry.handle);
+			continue;
+		}
+
+		if(openDevices) {
+			entry.state = DeviceState::DEVICE_STARTED;
+			buffer << " initialized (started)";
+			StartupTimeline::markDevicesReady();
+		}
+		else {
+			entry.state = DeviceState::DEVICE_STOPPED;
+			buffer << " initialized (stopped)";
+		}
+		initializedDevices.push_back(device.getID());
+
+		GKSysLogInfo(buffer.str());
+	}
 
 #if GKDBUS
 	if( initializedDevices.size() > 0 ) {
@@ -238,8 +271,6 @@ void DevicesManager::initializeDevices(const bool openDevices) noexcept
 	}
 #endif
 
-	_detectedDevices.clear();
-
 	GKLog2(info, "device(s) initialized: ", initializedDevices.size())
 }
 
@@ -249,37 +280,36 @@ const bool DevicesManager::startDevice(const std::string & devID)
 
 	GKLog2(trace, devID, " starting device")
 
-	try {
-		const auto & device = _stoppedDevices.at(devID);
-		for(const auto & driver : _drivers) {
-			if( device.getDriverID() == driver->getDriverID() ) {
-				driver->initializeDevice( device );
-				driver->openDevice( device ); /* throws GLogiKExcept on any failure */
-
-				std::ostringstream buffer(std::ios_base::app);
-				buffer	<< device.getFullName() << " "
-						<< device.getVendorID() << ":" << device.getProductID()
-						<< " on bus " << toUInt(device.getBus()) << " initialized";
-				GKSysLogInfo(buffer.str());
+	DeviceEntry* pEntry = _devices.findDevice(devID);
+	if( (pEntry == nullptr) or (pEntry->state != DeviceState::DEVICE_STOPPED) ) {
+		GKSysLogError("device starting failure : device not found in stopped devices : ", devID);
+		return false;
+	}
 
-				_startedDevices[devID] = device;
-				_stoppedDevices.erase(devID);
+	const auto & device = pEntry->device;
 
-				return true;
-			}
-		}
+	try {
+		pEntry->pDriver->initializeDevice( device );
+		pEntry->pDriver->openDevice( device ); /* throws GLogiKExcept on any failure */
 	}
-	catch (const std::out_of_range& oor) {
-		GKSysLogError("device starting failure : device not found in stopped devices container : ", oor.what());
+	catch ( const GLogiKExcept & e ) {
+		GKSysLogError("device failure : ", e.what());
 		return false;
 	}
-	catch ( const GLogiKExcept & e ) {
+	catch ( const std::exception & e ) {
 		GKSysLogError("device failure : ", e.what());
 		return false;
 	}
 
-	GKSysLogError("device starting failure : driver not found !?");
-	return false;
+	std::ostringstream buffer(std::ios_base::app);
+	buffer	<< device.getFullName() << " "
+			<< device.getVendorID() << ":" << device.getProductID()
+			<< " on bus " << toUInt(device.getBus()) << " initialized";
+	GKSysLogInfo(buffer.str());
+
+	pEntry->state = DeviceState::DEVICE_STARTED;
+
+	return true;
 }
 
 const bool DevicesManager::stopDevice(
@@ -290,32 +320,25 @@ const bool DevicesManager::stopDevice(
 
 	GKLog2(trace, devID, " stopping device")
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		for(const auto & driver : _drivers) {
-			if( device.getDriverID() == driver->getDriverID() ) {
-				driver->closeDevice( device, skipUSBRequests );
+	DeviceEntry* pEntry = _devices.findDevice(devID);
+	if( (pEntry == nullptr) or (pEntry->state != DeviceState::DEVICE_STARTED) ) {
+		GKSysLogError("device stopping failure : device not found in started devices : ", devID);
+		return false;
+	}
 
-				std::ostringstream buffer(std::ios_base::app);
-				buffer	<< device.getFullName() << " "
-						<< device.getVendorID() << ":" << device.getProductID()
-						<< " on bus " << toUInt(device.getBus()) << " stopped";
-				GKSysLogInfo(buffer.str());
+	const auto & device = pEntry->device;
 
-				_stoppedDevices[devID] = device;
-				_startedDevices.erase(devID);
+	pEntry->pDriver->closeDevice( device, skipUSBRequests );
 
-				return true;
-			}
-		}
-	}
-	catch (const std::out_of_range& oor) {
-		GKSysLogError("device stopping failure : device not found in started devices container : ", oor.what());
-		return false;
-	}
+	std::ostringstream buffer(std::ios_base::app);
+	buffer	<< device.getFullName() << " "
+			<< device.getVendorID() << ":" << device.getProductID()
+			<< " on bus " << toUInt(device.getBus()) << " stopped";
+	GKSysLogInfo(buffer.str());
+
+	pEntry->state = DeviceState::DEVICE_STOPPED;
 
-	GKSysLogError("device stopping failure : driver not found !?");
-	return false;
+	return true;
 }
 
 void DevicesManager::startSleepingDevices(void)
@@ -324,11 +347,16 @@ void DevicesManager::startSleepingDevices(void)
 
 	GKLog(trace, "starting sleeping devices")
 
-	for(const auto & devID : _sleepingDevices) {
-		this->startDevice(devID);
-	}
+	const std::vector<std::string> startedDevices( this->startDevices(_sleepingDevices) );
 
 	_sleepingDevices.clear();
+
+#if GKDBUS
+	if( startedDevices.size() > 0 ) {
+		/* inform clients */
+		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesStarted", startedDevices);
+	}
+#endif
 }
 
 void DevicesManager::stopInitializedDevices(void)
@@ -337,148 +365,405 @@ void DevicesManager::stopInitializedDevices(void)
 
 	GKLog(trace, "stopping initialized devices")
 
+	/* already reported as stopped to clients */
+	for(const auto & handle : _devices.getDevices(DeviceState::DEVICE_SUSPENDED)) {
+		DeviceEntry & entry = _devices.getDevice(handle);
+		entry.pDriver->closeDevice( entry.device );
+		entry.state = DeviceState::DEVICE_STOPPED;
+	}
+
 	/* sleeping devices will potentially be started again right after resume */
+	_sleepingDevices = _devices.getDevicesIDs(DeviceState::DEVICE_STARTED);
+
+	const std::vector<std::string> stoppedDevices( this->stopDevices(_sleepingDevices, false) );
+
+#if GKDBUS
+	if( stoppedDevices.size() > 0 ) {
+		/* inform clients */
+		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesStopped", stoppedDevices);
+	}
+#endif
+}
+
+/*
+ * Sleep fast path, started devices are kept opened with
+ * their threads stopped, see ::resumeSuspendedDevices()
+ */
+void DevicesManager::suspendInitializedDevices(void)
+{
+	GK_LOG_FUNC
+
+	GKLog(trace, "suspending initialized devices")
+
 	_sleepingDevices.clear();
+	DevicesJobs_type jobs;
 
-	for(const auto & devicePair : _startedDevices) {
-		_sleepingDevices.push_back(devicePair.first);
+	for(const auto & handle : _devices.getDevices(DeviceState::DEVICE_STARTED)) {
+		DeviceEntry & entry = _devices.getDevice(handle);
+		jobs.push_back( {&entry, true, ""} );
 	}
 
-	for(const auto & devID : _sleepingDevices) {
-		this->stopDevice(devID);
+	this->runDevicesJobs(jobs,
+		[] (DeviceJob & job) -> void {
+			job.pEntry->pDriver->suspendDevice( job.pEntry->device );
+		}
+	);
+
+	for(const auto & job : jobs) {
+		job.pEntry->state = DeviceState::DEVICE_SUSPENDED;
+		_sleepingDevices.push_back( job.pEntry->device.getID() );
 	}
 
-	_startedDevices.clear();
+#if GKDBUS
+	if( _sleepingDevices.size() > 0 ) {
+		/* inform clients */
+		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesStopped", _sleepingDevices);
+	}
+#endif
 }
 
-void DevicesManager::checkInitializedDevicesThreadsStatus(void) noexcept
+/*
+ * Resumes suspended devices in place. Devices which did not
+ * survive the sleep are closed and left in the sleeping devices
+ * for ::startSleepingDevices(). Returns true if all devices
+ * were resumed.
+ */
+const bool DevicesManager::resumeSuspendedDevices(void)
 {
 	GK_LOG_FUNC
 
-	//GKLog(trace, "checking initialized devices threads status")
+	GKLog(trace, "resuming suspended devices")
 
-#if GKDBUS
-	std::vector<std::string> toSend;
-#endif
+	std::vector<std::string> resumedDevices;
+	DevicesJobs_type jobs;
 
-	std::vector<std::string> toCheck;
-	for(const auto& devicePair : _startedDevices) {
-		toCheck.push_back(devicePair.first);
+	for(const auto & handle : _devices.getDevices(DeviceState::DEVICE_SUSPENDED)) {
+		DeviceEntry & entry = _devices.getDevice(handle);
+		jobs.push_back( {&entry, true, ""} );
 	}
 
-	for(const auto & devID : toCheck) {
-		for(const auto & driver : _drivers) {
-			auto & device = _startedDevices.at(devID);
+	this->runDevicesJobs(jobs,
+		[] (DeviceJob & job) -> void {
+			job.success = job.pEntry->pDriver->resumeDevice( job.pEntry->device );
+		}
+	);
 
-			if( device.getDriverID() == driver->getDriverID() ) {
-				if( ! driver->getDeviceThreadsStatus(devID) ) {
-					GKSysLogWarning("USB port software reset detected, not cool :(");
-					GKSysLogWarning("We are forced to hard stop a device.");
-					GKSysLogWarning("You will get libusb warnings/errors if you do this.");
+	for(const auto & job : jobs) {
+		const std::string & devID = job.pEntry->device.getID();
 
-					this->stopDevice(devID, true);
-#if GKDBUS
-					toSend.push_back(devID);
-#endif
-				}
-			}
+		if( ! job.success ) {
+			/* closed, will be opened again */
+			job.pEntry->state = DeviceState::DEVICE_STOPPED;
+			continue;
 		}
+
+		job.pEntry->state = DeviceState::DEVICE_STARTED;
+		resumedDevices.push_back(devID);
+
+		_sleepingDevices.erase(
+			std::remove(_sleepingDevices.begin(), _sleepingDevices.end(), devID),
+			_sleepingDevices.end()
+		);
 	}
 
+	GKLog4(trace, "resumed devices : ", resumedDevices.size(), "to restart : ", _sleepingDevices.size())
+
 #if GKDBUS
-	if( toSend.size() > 0 ) {
+	if( resumedDevices.size() > 0 ) {
 		/* inform clients */
-		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesStopped", toSend);
+		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesStarted", resumedDevices);
 	}
 #endif
+
+	return _sleepingDevices.empty();
 }
 
-void DevicesManager::checkForUnpluggedDevices(void) noexcept
+/* returns initialized (started or stopped) device, or nullptr */
+const DeviceEntry* DevicesManager::findInitializedDevice(const std::string & devID) const
+{
+	const DeviceEntry* pEntry = _devices.findDevice(devID);
+	if( (pEntry != nullptr) and
+		( (pEntry->state == DeviceState::DEVICE_STARTED) or
+		  (pEntry->state == DeviceState::DEVICE_STOPPED) or
+		  (pEntry->state == DeviceState::DEVICE_SUSPENDED) ) ) {
+		return pEntry;
+	}
+
+	GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
+	return nullptr;
+}
+
+/*
+ * Runs jobs on a small pool of worker threads, the calling
+ * thread being one of them. Jobs are picked up in order from
+ * a shared index. jobFunction must not throw.
+ */
+void DevicesManager::runDevicesJobs(
+	DevicesJobs_type & jobs,
+	const std::function<void(DeviceJob &)> & jobFunction) noexcept
 {
 	GK_LOG_FUNC
 
-	GKLog(trace, "checking for unplugged devices")
+	if( jobs.empty() )
+		return;
 
-#if GKDBUS
-	std::vector<std::string> toSend;
-#endif
+	unsigned int numWorkers = std::thread::hardware_concurrency();
+	if(numWorkers == 0)
+		numWorkers = 1;
+	numWorkers = std::min( {numWorkers, _maxWorkers, static_cast<unsigned int>(jobs.size())} );
+
+	GKLog4(trace, "running devices jobs : ", jobs.size(), "workers : ", numWorkers)
+
+	std::atomic<std::size_t> nextJob(0);
+
+	auto worker = [&jobs, &jobFunction, &nextJob] () -> void {
+		for(std::size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+			jobFunction(jobs[i]);
+		}
+	};
 
-	/* checking for unplugged unstopped devices */
-	std::vector<std::string> toClean;
-	for(const auto & devicePair : _startedDevices) {
-		if( _detectedDevices.count(devicePair.first) == 0 ) {
-			toClean.push_back(devicePair.first);
+	std::vector<std::thread> workers;
+	try {
+		for(unsigned int i = 1; i < numWorkers; ++i) {
+			workers.emplace_back(worker);
 		}
 	}
+	catch (const std::system_error& e) {
+		/* remaining jobs will be run by the already spawned workers */
+		GKSysLogWarning("error while spawning devices worker thread : ", e.what());
+	}
+
+	worker();
+
+	for(auto & t : workers) {
+		t.join();
+	}
+}
+
+/* parallel version of ::startDevice(), returns started devices IDs */
+const std::vector<std::string> DevicesManager::startDevices(const std::vector<std::string> & devIDs)
+{
+	GK_LOG_FUNC
+
+	std::vector<std::string> startedDevices;
+	DevicesJobs_type jobs;
+
+	for(const auto & devID : devIDs) {
+		DeviceEntry* pEntry = _devices.findDevice(devID);
+		if( (pEntry == nullptr) or (pEntry->state != DeviceState::DEVICE_STOPPED) ) {
+			GKSysLogError("device starting failure : device not found in stopped devices : ", devID);
+			continue;
+		}
 
-	for(const auto & devID : toClean) {
 		try {
-			{
-				auto & device = _startedDevices.at(devID);
-				std::ostringstream buffer(std::ios_base::app);
-				buffer	<< devID << " erasing unplugged initialized driver : "
-						<< device.getVendorID() << ":" << device.getProductID()
-						<< ":" << device.getDevnode() << ":" << device.getUSec();
-
-				GKSysLogWarning(buffer.str());
-				GKSysLogWarning("Did you unplug your device before properly stopping it ?");
-				GKSysLogWarning("You will get libusb warnings/errors if you do this.");
-			}
+			pEntry->pDriver->initializeDevice( pEntry->device );
+			jobs.push_back( {pEntry, true, ""} );
+		}
+		catch ( const GLogiKExcept & e ) {
+			jobs.push_back( {pEntry, false, e.what()} );
+		}
+		catch ( const std::exception & e ) {
+			jobs.push_back( {pEntry, false, e.what()} );
+		}
+	}
 
-			if( this->stopDevice(devID, true) ) {
-				const auto & device = _stoppedDevices.at(devID);
-				_unpluggedDevices[devID] = device;
-				_stoppedDevices.erase(devID);
-#if GKDBUS
-				toSend.push_back(devID);
-#endif
+	this->runDevicesJobs(jobs,
+		[] (DeviceJob & job) -> void {
+			/* initialization failure */
+			if( ! job.success )
+				return;
+
+			try {
+				job.pEntry->pDriver->openDevice( job.pEntry->device ); /* throws GLogiKExcept on any failure */
+			}
+			catch ( const GLogiKExcept & e ) {
+				job.success = false;
+				job.error = e.what();
 			}
 		}
-		catch (const std::out_of_range& oor) {
-			std::ostringstream buffer(std::ios_base::app);
-			buffer << devID << " device not found";
-			GKSysLogWarning(buffer.str());
+	);
+
+	for(const auto & job : jobs) {
+		const auto & device = job.pEntry->device;
+
+		if( ! job.success ) {
+			GKSysLogError("device failure : ", job.error);
+			continue;
 		}
+
+		std::ostringstream buffer(std::ios_base::app);
+		buffer	<< device.getFullName() << " "
+				<< device.getVendorID() << ":" << device.getProductID()
+				<< " on bus " << toUInt(device.getBus()) << " initialized";
+		GKSysLogInfo(buffer.str());
+
+		job.pEntry->state = DeviceState::DEVICE_STARTED;
+		startedDevices.push_back(device.getID());
 	}
 
-	toClean.clear();
+	return startedDevices;
+}
+
+/* parallel version of ::stopDevice(), returns stopped devices IDs */
+const std::vector<std::string> DevicesManager::stopDevices(
+	const std::vector<std::string> & devIDs,
+	const bool skipUSBRequests)
+{
+	GK_LOG_FUNC
 
-	/* checking for unplugged but stopped devices */
-	for(const auto & devicePair : _stoppedDevices) {
-		if(_detectedDevices.count(devicePair.first) == 0 ) {
-			toClean.push_back(devicePair.first);
+	std::vector<std::string> stoppedDevices;
+	DevicesJobs_type jobs;
+
+	for(const auto & devID : devIDs) {
+		DeviceEntry* pEntry = _devices.findDevice(devID);
+		if( (pEntry == nullptr) or (pEntry->state != DeviceState::DEVICE_STARTED) ) {
+			GKSysLogError("device stopping failure : device not found in started devices : ", devID);
+			continue;
 		}
+
+		jobs.push_back( {pEntry, true, ""} );
 	}
-	for(const auto & devID : toClean) {
-		try {
-			GKLog2(trace, devID, " removing device from stopped-devices container")
-			const auto & device = _stoppedDevices.at(devID);
-			_unpluggedDevices[devID] = device;
-			_stoppedDevices.erase(devID);
+
+	this->runDevicesJobs(jobs,
+		[skipUSBRequests] (DeviceJob & job) -> void {
+			job.pEntry->pDriver->closeDevice( job.pEntry->device, skipUSBRequests );
+		}
+	);
+
+	for(const auto & job : jobs) {
+		const auto & device = job.pEntry->device;
+
+		std::ostringstream buffer(std::ios_base::app);
+		buffer	<< device.getFullName() << " "
+				<< device.getVendorID() << ":" << device.getProductID()
+				<< " on bus " << toUInt(device.getBus()) << " stopped";
+		GKSysLogInfo(buffer.str());
+
+		job.pEntry->state = DeviceState::DEVICE_STOPPED;
+		stoppedDevices.push_back(device.getID());
+	}
+
+	return stoppedDevices;
+}
+
+/*
+ * Called when the devices eventfd is readable : at least
+ * one device thread reported a failure and gave up.
+ */
+void DevicesManager::handleDevicesFailures(void) noexcept
+{
+	GK_LOG_FUNC
+
+	uint64_t events = 0;
+	if( read(_devicesEventFD, &events, sizeof(events)) != sizeof(events) ) {
+		/* EAGAIN, already consumed */
+		return;
+	}
+
+	GKLog2(trace, "devices failure events : ", events)
+
 #if GKDBUS
-			toSend.push_back(devID);
+	std::vector<std::string> toSend;
 #endif
+
+	for(const auto & driver : _drivers) {
+		for(const auto & devID : driver->getFailedDevices()) {
+			/* both device threads may report the same failure,
+			 * and the device may have been stopped in between */
+			const DeviceEntry* pEntry = _devices.findDevice(devID);
+			if( (pEntry == nullptr) or (pEntry->state != DeviceState::DEVICE_STARTED) )
+				continue;
+
+			GKSysLogWarning("USB port software reset detected, not cool :(");
+			GKSysLogWarning("We are forced to hard stop a device.");
+			GKSysLogWarning("You will get libusb warnings/errors if you do this.");
+
+			if( this->stopDevice(devID, true) ) {
+#if GKDBUS
+				toSend.push_back(devID);
+#endif
+			}
 		}
-		catch (const std::out_of_range& oor) {
+	}
+
+#if GKDBUS
+	if( toSend.size() > 0 ) {
+		/* inform clients */
+		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesStopped", toSend);
+	}
+#endif
+}
+
+/*
+ * Called on udev 'remove' events, the removed device is identified
+ * by its bus and device numbers, and checked against its devpath.
+ */
+void DevicesManager::checkForUnpluggedDevice(struct udev_device * pDevice) noexcept
+{
+	GK_LOG_FUNC
+
+	GKLog(trace, "checking for unplugged device")
+
+	std::string devID;
+	try {
+		const uint8_t bus = std::stoi( toString( udev_device_get_property_value(pDevice, "BUSNUM")) );
+		const uint8_t num = std::stoi( toString( udev_device_get_property_value(pDevice, "DEVNUM")) );
+		devID = USBDeviceID::getDeviceID(bus, num);
+	}
+	catch (const std::exception & e) {
+		GKLog(trace, "removed device without bus or device number, skipping")
+		return;
+	}
+
+	const std::string devpath( toString( udev_device_get_property_value(pDevice, "DEVPATH") ) );
+
+	DeviceEntry* pEntry = _devices.findDevice(devID);
+	if( (pEntry == nullptr) or
+		( ( ! devpath.empty() ) and (pEntry->device.getDevpath() != devpath) ) ) {
+		GKLog2(trace, devID, " removed device not handled")
+		return;
+	}
+
+	/* unplugged unstopped device */
+	if( pEntry->state == DeviceState::DEVICE_STARTED ) {
+		{
+			const auto & device = pEntry->device;
 			std::ostringstream buffer(std::ios_base::app);
-			buffer << "!?! device not found !?! " << devID;
+			buffer	<< devID << " erasing unplugged initialized driver : "
+					<< device.getVendorID() << ":" << device.getProductID()
+					<< ":" << device.getDevnode() << ":" << device.getUSec();
+
 			GKSysLogWarning(buffer.str());
+			GKSysLogWarning("Did you unplug your device before properly stopping it ?");
+			GKSysLogWarning("You will get libusb warnings/errors if you do this.");
 		}
+
+		if( ! this->stopDevice(devID, true) )
+			return;
 	}
-	toClean.clear();
 
-	_detectedDevices.clear();
+	/* unplugged while sleeping */
+	if( pEntry->state == DeviceState::DEVICE_SUSPENDED ) {
+		GKLog2(trace, devID, " closing unplugged suspended device")
+		pEntry->pDriver->closeDevice( pEntry->device, true );
+		pEntry->state = DeviceState::DEVICE_STOPPED;
+	}
+
+	/* unplugged stopped device */
+	if( pEntry->state != DeviceState::DEVICE_STOPPED ) {
+		GKLog2(trace, devID, " removed device not handled")
+		return;
+	}
+
+	GKLog2(trace, devID, " device is now unplugged")
+	pEntry->state = DeviceState::DEVICE_UNPLUGGED;
 
 #if GKDBUS
-	GKLog2(trace, "number of unplugged devices : ", toSend.size())
+	const std::vector<std::string> toSend = {devID};
 
-	if(toSend.size() > 0) {
-		/* inform clients */
-		this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesUnplugged", toSend);
-	}
+	/* inform clients */
+	this->sendStatusSignalArrayToClients(_numClients, _pDBus, "DevicesUnplugged", toSend);
 #endif
-
-	GKLog2(trace, "number of devices still initialized : ", _startedDevices.size())
 }
 
 #if DEBUGGING_ON
@@ -523,6 +808,163 @@ void udevDeviceProperties(struct udev_device * pDevice, const std::string & subS
 }
 #endif
 
+/* supported devices hash key : (vendor ID << 16 | product ID) */
+const uint32_t DevicesManager::getSupportedDeviceKey(
+	const std::string & vendorID,
+	const std::string & productID) noexcept
+{
+	try {
+		const unsigned long vid = std::stoul(vendorID, nullptr, 16);
+		const unsigned long pid = std::stoul(productID, nullptr, 16);
+		return ( ( (vid & 0xFFFF) << 16 ) | (pid & 0xFFFF) );
+	}
+	catch (const std::exception & e) {
+		return 0;
+	}
+}
+
+void DevicesManager::buildSupportedDevicesTable(void)
+{
+	GK_LOG_FUNC
+
+	_supportedDevices.clear();
+
+	for(const auto & driver : _drivers) {
+		for(const auto & device : driver->getSupportedDevices()) {
+			const uint32_t key = DevicesManager::getSupportedDeviceKey(
+				device.getVendorID(), device.getProductID()
+			);
+			if(key == 0) {
+				LOG(warning) << "wrong supported device ID : "
+							<< device.getVendorID() << ":" << device.getProductID();
+				continue;
+			}
+			_supportedDevices[key] = { driver, &device };
+		}
+	}
+
+	GKLog2(trace, "number of supported devices : ", _supportedDevices.size())
+}
+
+/*
+ * Checks if the given udev device is supported, and adds it
+ * to the devices registry in detected state in this case.
+ * Throws GLogiKExcept on bus and device numbers failure.
+ */
+const bool DevicesManager::detectSupportedDevice(struct udev_device * pDevice)
+{
+	GK_LOG_FUNC
+
+	const std::string vendorID( toString( udev_device_get_property_value(pDevice, "ID_VENDOR_ID") ) );
+	const std::string productID( toString( udev_device_get_property_value(pDevice, "ID_MODEL_ID") ) );
+	if( vendorID.empty() or productID.empty() )
+		return false;
+
+	auto it = _supportedDevices.find( DevicesManager::getSupportedDeviceKey(vendorID, productID) );
+	if( it == _supportedDevices.end() )
+		return false;
+
+	KeyboardDriver* driver = (*it).second.pDriver;
+	const USBDeviceID & device = *((*it).second.pDevice);
+
+	// path to the event device node in /dev
+	const std::string devnode( toString( udev_device_get_devnode(pDevice) ) );
+	if( devnode.empty() )
+		return false;
+
+#if DEBUGGING_ON
+	const std::string devss( toString( udev_device_get_subsystem(pDevice) ) );
+	udevDeviceProperties(pDevice, devss);
+#endif
+
+	//const std::string vendor( toString( udev_device_get_property_value(pDevice, "ID_VENDOR") ) );
+	//const std::string model( toString( udev_device_get_property_value(pDevice, "ID_MODEL") ) );
+	const std::string serial( toString( udev_device_get_property_value(pDevice, "ID_SERIAL") ) );
+	const std::string usec( toString( udev_device_get_property_value(pDevice, "USEC_INITIALIZED") ) );
+
+	uint8_t bus, num = 0;
+
+	try {
+		bus = std::stoi( toString( udev_device_get_property_value(pDevice, "BUSNUM")) );
+		num = std::stoi( toString( udev_device_get_property_value(pDevice, "DEVNUM")) );
+	}
+	catch (const std::invalid_argument& ia) {
+		throw GLogiKExcept("stoi invalid argument");
+	}
+	catch (const std::out_of_range& oor) {
+		throw GLogiKExcept("stoi out of range");
+	}
+
+	const std::string devID( USBDeviceID::getDeviceID(bus, num) );
+
+	const std::string devpath( toString( udev_device_get_property_value(pDevice, "DEVPATH") ) );
+	if( devpath.empty() )
+		return false;
+
+	const DeviceEntry* pEntry = _devices.findDevice(devID);
+	if( pEntry != nullptr ) {
+		const auto & d = pEntry->device;
+		switch(pEntry->state) {
+			case DeviceState::DEVICE_DETECTED: {
+					std::ostringstream buffer(std::ios_base::app);
+					buffer << devID << " found already detected device : " << d.getDevnode();
+					GKSysLogWarning(buffer.str());
+				}
+				return true;
+			case DeviceState::DEVICE_STARTED:
+#if DEBUGGING_ON
+				if(GKLogging::GKDebug) {
+					LOG(trace)	<< "device already started : "
+								<< d.getVendorID() << ":"
+								<< d.getProductID() << " - "
+								<< d.getDevnode();
+				}
+#endif
+				return true;
+			// TODO option ?
+			case DeviceState::DEVICE_STOPPED:
+			case DeviceState::DEVICE_SUSPENDED:
+#if DEBUGGING_ON
+				if(GKLogging::GKDebug) {
+					LOG(trace)	<< "device already initialized, but is in stopped state : "
+								<< d.getVendorID() << ":"
+								<< d.getProductID() << " - "
+								<< d.getDevnode();
+					LOG(trace)	<< "automatic initialization is disabled for stopped devices";
+				}
+#endif
+				return true;
+			default:
+				/* unplugged device, bus and device numbers reused */
+				break;
+		}
+	}
+
+	USBDeviceID found(
+		device,
+		devnode,
+		devpath,
+		serial,
+		usec,
+		driver->getDriverID(),
+		bus, num
+	);
+
+	_devices.addDevice(std::move(found), driver, DeviceState::DEVICE_DETECTED);
+
+#if DEBUGGING_ON
+	if(GKLogging::GKDebug) {
+		LOG(trace)	<< "found device - Vid:Pid:node:usec | bus:num - "
+					<< vendorID << ":" << productID << ":"
+					<< devnode << ":" << usec
+					<< " | " << toUInt(bus) << ":" << toUInt(num);
+	}
+#endif
+
+	return true;
+}
+
+/* full usb subsystem scan, only done on startup */
 void DevicesManager::searchSupportedDevices(struct udev * pUdev)
 {
 	GK_LOG_FUNC
@@ -564,99 +1006,12 @@ void DevicesManager::searchSupportedDevices(struct udev * pUdev)
 				continue;
 			}
 
-#if DEBUGGING_ON
-			const std::string devss( toString( udev_device_get_subsystem(dev) ) );
-			if( devss.empty() ) {
-				udev_device_unref(dev);
-				throw GLogiKExcept("get_subsystem failure");
+			try { /* dev unref on catch */
+				this->detectSupportedDevice(dev);
 			}
-
-			//udevDeviceProperties(dev, devss);
-#endif
-
-			const std::string vendorID( toString( udev_device_get_property_value(dev, "ID_VENDOR_ID") ) );
-			const std::string productID( toString( udev_device_get_property_value(dev, "ID_MODEL_ID") ) );
-			if( vendorID.empty() or productID.empty() ) {
+			catch ( const GLogiKExcept & e ) {
 				udev_device_unref(dev);
-				continue;
-			}
-
-			for(const auto & driver : _drivers) {
-				for(const auto& device : driver->getSupportedDevices()) {
-					if( device.getVendorID() == vendorID ) {
-						if( device.getProductID() == productID ) {
-
-							// path to the event device node in /dev
-							const std::string devnode( toString( udev_device_get_devnode(dev) ) );
-							if( devnode.empty() ) {
-								udev_device_unref(dev);
-								continue;
-							}
-
-#if DEBUGGING_ON
-							udevDeviceProperties(dev, devss);
-#endif
-
-							//const std::string vendor( toString( udev_device_get_property_value(dev, "ID_VENDOR") ) );
-							//const std::string model( toString( udev_device_get_property_value(dev, "ID_MODEL") ) );
-							const std::string serial( toString( udev_device_get_property_value(dev, "ID_SERIAL") ) );
-							const std::string usec( toString( udev_device_get_property_value(dev, "USEC_INITIALIZED") ) );
-
-							uint8_t bus, num = 0;
-
-							try {
-								bus = std::stoi( toString( udev_device_get_property_value(dev, "BUSNUM")) );
-								num = std::stoi( toString( udev_device_get_property_value(dev, "DEVNUM")) );
-							}
-							catch (const std::invalid_argument& ia) {
-								udev_device_unref(dev);
-								throw GLogiKExcept("stoi invalid argument");
-							}
-							catch (const std::out_of_range& oor) {
-								udev_device_unref(dev);
-								throw GLogiKExcept("stoi out of range");
-							}
-
-							const std::string devID( USBDeviceID::getDeviceID(bus, num) );
-
-							const std::string devpath( toString( udev_device_get_property_value(dev, "DEVPATH") ) );
-							if( devpath.empty() ) {
-								udev_device_unref(dev);
-								continue;
-							}
-
-							try {
-								const USBDeviceID & d = _detectedDevices.at(devID);
-								std::ostringstream buffer(std::ios_base::app);
-								buffer << devID << " found already detected device : " << d.getDevnode();
-								GKSysLogWarning(buffer.str());
-							}
-							catch (const std::out_of_range& oor) {
-
-								USBDeviceID found(
-									device,
-									devnode,
-									devpath,
-									serial,
-									usec,
-									driver->getDriverID(),
-									bus, num
-								);
-
-								_detectedDevices[devID] = found;
-
-#if DEBUGGING_ON
-								if(GKLogging::GKDebug) {
-									LOG(trace)	<< "found device - Vid:Pid:node:usec | bus:num - "
-												<< vendorID << ":" << productID << ":"
-												<< devnode << ":" << usec
-												<< " | " << toUInt(bus) << ":" << toUInt(num);
-								}
-#endif
-							}
-						}
-					}
-				}
+				throw;
 			}
 
 			udev_device_unref(dev);
@@ -672,31 +1027,63 @@ void DevicesManager::searchSupportedDevices(struct udev * pUdev)
 	// Free the enumerator object
 	udev_enumerate_unref(enumerate);
 
-	GKLog2(trace, "number of found device(s) : ", _detectedDevices.size())
+	GKLog2(trace, "number of found device(s) : ", _devices.getDevices(DeviceState::DEVICE_DETECTED).size())
 }
 
-const std::vector<std::string> DevicesManager::getStartedDevices(void) const
+#if GKSIMUSB
+/*
+ * USB simulator build, replaces the udev scan : adds the
+ * scripted number of devices for each driver first supported
+ * device, on a bus number never used by real devices
+ */
+void DevicesManager::searchSimulatedDevices(void)
 {
-	std::vector<std::string> ret;
+	GK_LOG_FUNC
 
-	// dev code
-	//std::vector<std::string> ret = {"aaa1", "bbb2", "ccc3"};
+	GKLog(trace, "adding simulated devices")
 
-	for(const auto& devicePair : _startedDevices) {
-		ret.push_back(devicePair.first);
+	for(const auto & driver : _drivers) {
+		const auto & supported = driver->getSupportedDevices();
+		if( supported.empty() )
+			continue;
+
+		for(unsigned int i = 1; i <= simusb::getSimulatedDevicesCount(); i++) {
+			const std::string num( std::to_string(i) );
+
+			USBDeviceID found(
+				supported.front(),
+				"/dev/simusb/" + num,
+				"/simusb/" + num,
+				"SIMUSB" + num,
+				"0",
+				driver->getDriverID(),
+				simusb::simulatedBus,
+				static_cast<uint8_t>(i)
+			);
+
+			_devices.addDevice(std::move(found), driver, DeviceState::DEVICE_DETECTED);
+		}
 	}
 
-	return ret;
+	GKLog2(trace, "number of simulated device(s) : ", _devices.getDevices(DeviceState::DEVICE_DETECTED).size())
 }
+#endif
 
-const std::vector<std::string> DevicesManager::getStoppedDevices(void) const
+const std::vector<std::string> DevicesManager::getStartedDevices(void) const
 {
-	std::vector<std::string> ret;
+	// dev code
+	//std::vector<std::string> ret = {"aaa1", "bbb2", "ccc3"};
 
-	for(const auto & devicePair : _stoppedDevices) {
-		ret.push_back(devicePair.first);
-	}
+	return _devices.getDevicesIDs(DeviceState::DEVICE_STARTED);
+}
 
+const std::vector<std::string> DevicesManager::getStoppedDevices(void) const
+{
+	/* suspended devices are seen as stopped by clients */
+	std::vector<std::string> ret( _devices.getDevicesIDs(DeviceState::DEVICE_STOPPED) );
+	for(const auto & devID : _devices.getDevicesIDs(DeviceState::DEVICE_SUSPENDED)) {
+		ret.push_back(devID);
+	}
 	return ret;
 }
 
@@ -704,19 +1091,9 @@ const std::string & DevicesManager::getDeviceVendor(const std::string & devID) c
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		return device.getVendor();
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			return device.getVendor();
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
-	}
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if(pEntry != nullptr)
+		return pEntry->device.getVendor();
 
 	return _unknown;
 }
@@ -725,19 +1102,9 @@ const uint64_t DevicesManager::getDeviceCapabilities(const std::string & devID)
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		return device.getCapabilities();
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			return device.getCapabilities();
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
-	}
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if(pEntry != nullptr)
+		return pEntry->device.getCapabilities();
 
 	return 0;
 }
@@ -746,19 +1113,9 @@ const std::string & DevicesManager::getDeviceProduct(const std::string & devID)
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		return device.getProduct();
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			return device.getProduct();
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
-	}
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if(pEntry != nullptr)
+		return pEntry->device.getProduct();
 
 	return _unknown;
 }
@@ -767,19 +1124,9 @@ const std::string & DevicesManager::getDeviceName(const std::string & devID) con
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		return device.getName();
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			return device.getName();
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
-	}
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if(pEntry != nullptr)
+		return pEntry->device.getName();
 
 	return _unknown;
 }
@@ -789,44 +1136,49 @@ const LCDPPArray_type &
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		GKLog2(trace, devID, " device is started")
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if(pEntry != nullptr)
+		return pEntry->pDriver->getDeviceLCDPluginsProperties(devID);
 
-		for(const auto & driver : _drivers) {
-			if( device.getDriverID() == driver->getDriverID() ) {
-				return driver->getDeviceLCDPluginsProperties(devID);
-			}
-		}
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			GKLog2(trace, devID, " device is stopped")
+	return LCDScreenPluginsManager::_LCDPluginsPropertiesEmptyArray;
+}
 
-			for(const auto & driver : _drivers) {
-				if( device.getDriverID() == driver->getDriverID() ) {
-					return driver->getDeviceLCDPluginsProperties(devID);
-				}
-			}
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
-	}
+const std::vector<std::string>
+	DevicesManager::getDeviceMetrics(const std::string & devID) const
+{
+	GK_LOG_FUNC
 
-	return LCDScreenPluginsManager::_LCDPluginsPropertiesEmptyArray;
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if(pEntry != nullptr)
+		return pEntry->pDriver->getDeviceMetrics(devID);
+
+	const std::vector<std::string> ret;
+	return ret;
 }
 
 const std::string DevicesManager::getDeviceStatus(const std::string & devID) const
 {
 	std::string ret(_unknown);
-	if(_startedDevices.count(devID) == 1)
-		ret = "started";
-	else if(_stoppedDevices.count(devID) == 1)
-		ret = "stopped";
-	else if(_unpluggedDevices.count(devID) == 1)
-		ret = "unplugged";
+
+	const DeviceEntry* pEntry = _devices.findDevice(devID);
+	if(pEntry == nullptr)
+		return ret;
+
+	switch(pEntry->state) {
+		case DeviceState::DEVICE_STARTED:
+			ret = "started";
+			break;
+		case DeviceState::DEVICE_STOPPED:
+		case DeviceState::DEVICE_SUSPENDED:
+			ret = "stopped";
+			break;
+		case DeviceState::DEVICE_UNPLUGGED:
+			ret = "unplugged";
+			break;
+		default:
+			break;
+	}
+
 	return ret;
 }
 
@@ -839,54 +1191,25 @@ void DevicesManager::setDeviceActiveConfiguration(
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		GKLog2(trace, devID, " device is started")
-
-		for(const auto & driver : _drivers) {
-			if( device.getDriverID() == driver->getDriverID() ) {
-				driver->setDeviceActiveConfiguration(devID, r, g, b, LCDPluginsMask1);
-				return;
-			}
-		}
-	}
-	catch (const std::out_of_range& oor) {
+	DeviceEntry* pEntry = _devices.findDevice(devID);
+	if( (pEntry == nullptr) or (pEntry->state != DeviceState::DEVICE_STARTED) ) {
 		GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
+		return;
 	}
+
+	GKLog2(trace, devID, " device is started")
+
+	pEntry->pDriver->setDeviceActiveConfiguration(devID, r, g, b, LCDPluginsMask1);
 }
 
 const MKeysIDArray_type DevicesManager::getDeviceMKeysIDArray(const std::string & devID) const
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		GKLog2(trace, devID, " device is started")
-
-		if( KeyboardDriver::checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
-			for(const auto & driver : _drivers) {
-				if( device.getDriverID() == driver->getDriverID() ) {
-					return driver->getMKeysIDArray();
-				}
-			}
-		}
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			GKLog2(trace, devID, " device is stopped")
-
-			if( KeyboardDriver::checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
-				for(const auto & driver : _drivers) {
-					if( device.getDriverID() == driver->getDriverID() ) {
-						return driver->getMKeysIDArray();
-					}
-				}
-			}
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if( (pEntry != nullptr) and
+		KeyboardDriver::checkDeviceCapability(pEntry->device, Caps::GK_MACROS_KEYS) ) {
+		return pEntry->pDriver->getMKeysIDArray();
 	}
 
 	MKeysIDArray_type ret;
@@ -897,34 +1220,10 @@ const GKeysIDArray_type DevicesManager::getDeviceGKeysIDArray(const std::string
 {
 	GK_LOG_FUNC
 
-	try {
-		const auto & device = _startedDevices.at(devID);
-		GKLog2(trace, devID, " device is started")
-
-		if( KeyboardDriver::checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
-			for(const auto & driver : _drivers) {
-				if( device.getDriverID() == driver->getDriverID() ) {
-					return driver->getGKeysIDArray();
-				}
-			}
-		}
-	}
-	catch (const std::out_of_range& oor) {
-		try {
-			const auto & device = _stoppedDevices.at(devID);
-			GKLog2(trace, devID, " device is stopped")
-
-			if( KeyboardDriver::checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
-				for(const auto & driver : _drivers) {
-					if( device.getDriverID() == driver->getDriverID() ) {
-						return driver->getGKeysIDArray();
-					}
-				}
-			}
-		}
-		catch (const std::out_of_range& oor) {
-			GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
-		}
+	const DeviceEntry* pEntry = this->findInitializedDevice(devID);
+	if( (pEntry != nullptr) and
+		KeyboardDriver::checkDeviceCapability(pEntry->device, Caps::GK_MACROS_KEYS) ) {
+		return pEntry->pDriver->getGKeysIDArray();
 	}
 
 	GKeysIDArray_type ret;
@@ -937,164 +1236,190 @@ void DevicesManager::resetDevicesStates(void)
 
 	GKLog(trace, "resetting initialized devices states")
 
-	for(const auto& devicePair : _startedDevices) {
-		const auto & device = devicePair.second;
-		for(const auto & driver : _drivers) {
-			if( device.getDriverID() == driver->getDriverID() ) {
-				driver->resetDeviceState( device );
-			}
-		}
+	for(const auto & handle : _devices.getDevices(DeviceState::DEVICE_STARTED)) {
+		DeviceEntry & entry = _devices.getDevice(handle);
+		entry.pDriver->resetDeviceState( entry.device );
 	}
 }
 
 /*
+ *	Sets up udev monitoring, loads the drivers then searches and
+ *	opens the supported devices. Does not use D-Bus, so it may run
+ *	while the daemon registers itself on the bus.
  *	Throws GLogiKExcept in many ways on udev related functions failures.
  *	USB library failures on devices start/stop are catched internally.
  */
-void DevicesManager::startMonitoring(void) {
+void DevicesManager::initializeMonitoring(void)
+{
 	GK_LOG_FUNC
 
-	GKLog(trace, "initializing libudev")
+	{
+		StartupTimeline::Phase phase("udev setup");
+
+		GKLog(trace, "initializing libudev")
 
-	struct udev * pUdev = udev_new();
-	if( pUdev == nullptr )
-		throw GLogiKExcept("udev context init failure");
+		_pUdev = udev_new();
+		if( _pUdev == nullptr )
+			throw GLogiKExcept("udev context init failure");
 
-	try { /* pUdev unref on catch */
-		struct udev_monitor * monitor = udev_monitor_new_from_netlink(pUdev, "udev");
-		if( monitor == nullptr )
+		_pMonitor = udev_monitor_new_from_netlink(_pUdev, "udev");
+		if( _pMonitor == nullptr )
 			throw GLogiKExcept("allocating udev monitor failure");
 
-		try { /* monitor unref on catch */
-			if( udev_monitor_filter_add_match_subsystem_devtype(monitor, "usb", nullptr) < 0 )
-				throw GLogiKExcept("usb monitor filtering init failure");
+		/* usb_device events only, with GLogiK udev tag (kernel-side filter) */
+		if( udev_monitor_filter_add_match_subsystem_devtype(_pMonitor, "usb", "usb_device") < 0 )
+			throw GLogiKExcept("usb monitor filtering init failure");
 
-			if( udev_monitor_enable_receiving(monitor) < 0 )
-				throw GLogiKExcept("monitor enabling failure");
+		if( udev_monitor_filter_add_match_tag(_pMonitor, GLOGIK_UDEV_TAG) < 0 )
+			throw GLogiKExcept("usb monitor tag filtering init failure");
 
-			pollfd fds[1];
-			{
-				int fd = udev_monitor_get_fd(monitor);
-				if( fd < 0 )
-					throw GLogiKExcept("can't get the monitor file descriptor");
+		if( udev_monitor_enable_receiving(_pMonitor) < 0 )
+			throw GLogiKExcept("monitor enabling failure");
 
-				fds[0].fd = fd;
-				fds[0].events = POLLIN;
-			}
+		/* device threads failures are posted here */
+		_devicesEventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if( _devicesEventFD < 0 )
+			throw GLogiKExcept("devices eventfd creation failure");
+	}
+
+	{
+		StartupTimeline::Phase phase("drivers loading");
 
-			GKLog(trace, "loading drivers")
+		GKLog(trace, "loading drivers")
 
-			try {
-				KeyboardDriver* driver = nullptr;
+		try {
+			KeyboardDriver* driver = nullptr;
 #if GKLIBUSB
-				driver = new LogitechG510<libusb>();
+			driver = new LogitechG510<libusb>();
 #elif GKHIDAPI
-				driver = new LogitechG510<hidapi>();
+			driver = new LogitechG510<hidapi>();
+#elif GKSIMUSB
+			driver = new LogitechG510<simusb>();
 #endif
 
 #if GKDBUS
-				driver->setDBus(_pDBus);
+			driver->setDBus(_pDBus);
 #endif
+			driver->setDevicesEventFD(_devicesEventFD);
 
-				_drivers.push_back( driver );
-			}
-			catch (const std::bad_alloc& e) { /* handle new() failure */
-				throw GLogiKBadAlloc("catch driver wrong allocation");
-			}
+			_drivers.push_back( driver );
+		}
+		catch (const std::bad_alloc& e) { /* handle new() failure */
+			throw GLogiKBadAlloc("catch driver wrong allocation");
+		}
+
+		this->buildSupportedDevicesTable();
+	}
+
+	{
+		StartupTimeline::Phase phase("devices search");
+#if GKSIMUSB
+		this->searchSimulatedDevices();
+#else
+		this->searchSupportedDevices(_pUdev);	/* throws GLogiKExcept on failure */
+#endif
+	}
+
+	{
+		StartupTimeline::Phase phase("devices initialization");
+		this->initializeDevices(true);
+	}
+}
+
+/*
+ *	Main loop, ::initializeMonitoring() must have been called before.
+ *	Throws GLogiKExcept on udev related functions failures.
+ */
+void DevicesManager::startMonitoring(void) {
+	GK_LOG_FUNC
 
-			this->searchSupportedDevices(pUdev);	/* throws GLogiKExcept on failure */
-			this->initializeDevices(true);
+	if( (_pMonitor == nullptr) or (_devicesEventFD < 0) )
+		throw GLogiKExcept("devices monitoring not initialized");
+
+	pollfd fds[2];
+	{
+		int fd = udev_monitor_get_fd(_pMonitor);
+		if( fd < 0 )
+			throw GLogiKExcept("can't get the monitor file descriptor");
+
+		fds[0].fd = fd;
+		fds[0].events = POLLIN;
+	}
+
+	fds[1].fd = _devicesEventFD;
+	fds[1].events = POLLIN;
 
 #if GKDBUS
-			/* send signal, even if no client registered, clients could have started before daemon */
-			this->sendSignalToClients(_numClients, _pDBus, "DaemonIsStarting", true);
+	/* send signal, even if no client registered, clients could have started before daemon */
+	this->sendSignalToClients(_numClients, _pDBus, "DaemonIsStarting", true);
 #endif
 
-			uint16_t c = 0;
-
-			while( DaemonControl::isDaemonRunning() )
-			{
-				int ret = poll(fds, 1, 100);
-
-				// receive data ?
-				if( ret > 0 ) {
-					struct udev_device *dev = udev_monitor_receive_device(monitor);
-					if( dev == nullptr )
-						throw GLogiKExcept("no device from receive_device(), something is wrong");
-
-					try { /* dev unref on catch */
-
-						/* kernel action value, or NULL
-						 * Usual actions are:
-						 *   add, remove, bind, unbind, change, move, online, offline
-						 */
-						const std::string action( toString( udev_device_get_action(dev) ) );
-
-						if( action.empty() )
-							throw GLogiKExcept("device_get_action() failure");
-
-						const std::string devnode( toString( udev_device_get_devnode(dev) ) );
-						if( devnode.empty() ) {
-							GKLog2(trace, "filtering empty devnode event : ", action)
-							udev_device_unref(dev);
-							continue;
-						}
-
-						/* only interested in 'add' or 'remove' events */
-						if(( action != "add" ) and ( action != "remove" )) {
-							GKLog2(trace, "filtering action : ", action)
-							udev_device_unref(dev);
-							continue;
-						}
-
-						GKLog2(trace, "device action : ", action)
-						GKLog2(trace, "device devnode: ", devnode)
-
-						this->searchSupportedDevices(pUdev);	/* throws GLogiKExcept on failure */
-
-						if( action == "add" ) {
-							this->initializeDevices(false);
-						}
-						else if( action == "remove" ) {
-							this->checkForUnpluggedDevices();
-						}
-						else {
-							/* clear detected devices container */
-							_detectedDevices.clear();
-						}
-					}
-					catch ( const GLogiKExcept & e ) {
-						udev_device_unref(dev);
-						throw;
-					}
+	while( DaemonControl::isDaemonRunning() )
+	{
+		int ret = poll(fds, 2, 100);
+
+		if( (ret > 0) and (fds[1].revents & POLLIN) ) {
+			this->handleDevicesFailures();
+		}
 
+		// receive data ?
+		if( (ret > 0) and (fds[0].revents & POLLIN) ) {
+			struct udev_device *dev = udev_monitor_receive_device(_pMonitor);
+			if( dev == nullptr )
+				throw GLogiKExcept("no device from receive_device(), something is wrong");
+
+			try { /* dev unref on catch */
+
+				/* kernel action value, or NULL
+				 * Usual actions are:
+				 *   add, remove, bind, unbind, change, move, online, offline
+				 */
+				const std::string action( toString( udev_device_get_action(dev) ) );
+
+				if( action.empty() )
+					throw GLogiKExcept("device_get_action() failure");
+
+				const std::string devnode( toString( udev_device_get_devnode(dev) ) );
+				if( devnode.empty() ) {
+					GKLog2(trace, "filtering empty devnode event : ", action)
 					udev_device_unref(dev);
+					continue;
 				}
 
-#if GKDBUS
-				this->checkDBusMessages();
-#endif
-				if(c++ >= 10) { /* bonus point */
-					this->checkInitializedDevicesThreadsStatus();
-					c = 0;
+				/* only interested in 'add' or 'remove' events */
+				if(( action != "add" ) and ( action != "remove" )) {
+					GKLog2(trace, "filtering action : ", action)
+					udev_device_unref(dev);
+					continue;
+				}
+
+				GKLog2(trace, "device action : ", action)
+				GKLog2(trace, "device devnode: ", devnode)
+
+				/* no full scan here, only the received device is checked */
+				if( action == "add" ) {
+					/* throws GLogiKExcept on failure */
+					if( this->detectSupportedDevice(dev) )
+						this->initializeDevices(false);
+				}
+				else {
+					this->checkForUnpluggedDevice(dev);
 				}
 			}
+			catch ( const GLogiKExcept & e ) {
+				udev_device_unref(dev);
+				throw;
+			}
 
-		} // try
-		catch ( const GLogiKExcept & e ) {
-			udev_monitor_unref(monitor);
-			throw;
+			udev_device_unref(dev);
 		}
 
-		udev_monitor_unref(monitor);
+#if GKDBUS
+		this->checkDBusMessages();
+#endif
 
-	} // try
-	catch ( const GLogiKExcept & e ) {
-		udev_unref(pUdev);
-		throw;
+		GKTrace::checkDumpRequest();
 	}
-
-	udev_unref(pUdev);
 }
 
 } // namespace GLogiK
@@ -25,8 +25,9 @@
 #include <cstdint>
 
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
+#include <functional>
 
 #include <config.h>
 
@@ -37,6 +38,7 @@
 #endif
 
 #include "keyboardDriver.hpp"
+#include "devicesRegistry.hpp"
 
 #include "USBDeviceID.hpp"
 
@@ -50,6 +52,22 @@ namespace GLogiK
 void udevDeviceProperties(struct udev_device * pDevice, const std::string & subSystem);
 #endif
 
+struct SupportedDevice
+{
+	KeyboardDriver* pDriver;
+	const USBDeviceID* pDevice;
+};
+
+/* device open/close job, run on the devices worker pool */
+struct DeviceJob
+{
+	DeviceEntry* pEntry;
+	bool success;
+	std::string error;
+};
+
+typedef std::vector<DeviceJob> DevicesJobs_type;
+
 class DevicesManager
 #if GKDBUS
 	:	public ClientsSignals
@@ -61,6 +79,7 @@ class DevicesManager
 
 		static const std::string getLibudevVersion(void);
 
+		void initializeMonitoring(void);
 		void startMonitoring(void);
 
 #if GKDBUS
@@ -72,6 +91,8 @@ class DevicesManager
 
 		void startSleepingDevices(void);
 		void stopInitializedDevices(void);
+		void suspendInitializedDevices(void);
+		const bool resumeSuspendedDevices(void);
 
 		void resetDevicesStates(void);
 		const bool startDevice(const std::string & devID);
@@ -89,6 +110,7 @@ class DevicesManager
 		const LCDPPArray_type & getDeviceLCDPluginsProperties(
 			const std::string & devID
 		) const;
+		const std::vector<std::string> getDeviceMetrics(const std::string & devID) const;
 
 		void setDeviceActiveConfiguration(
 			const std::string & devID,
@@ -105,24 +127,51 @@ class DevicesManager
 	protected:
 
 	private:
-		std::map<std::string, USBDeviceID> _detectedDevices;
-		std::map<std::string, USBDeviceID> _startedDevices;
-		std::map<std::string, USBDeviceID> _stoppedDevices;
-		std::map<std::string, USBDeviceID> _unpluggedDevices;
+		DevicesRegistry _devices;
 		std::vector<std::string> _sleepingDevices;
 		std::vector<KeyboardDriver*> _drivers;
+		/* maximum number of devices worker threads */
+		static constexpr unsigned int _maxWorkers = 4;
+		/* supported devices, (vendor ID, product ID) hash key */
+		std::unordered_map<uint32_t, SupportedDevice> _supportedDevices;
 		const std::string _unknown;
+		/* device threads failures notifications */
+		int _devicesEventFD;
+		/* udev context and monitor, see ::initializeMonitoring() */
+		struct udev * _pUdev;
+		struct udev_monitor * _pMonitor;
 
 #if GKDBUS
 		NSGKDBus::GKDBus* _pDBus;
 		uint8_t _numClients;
 #endif
 
+		static const uint32_t getSupportedDeviceKey(
+			const std::string & vendorID,
+			const std::string & productID
+		) noexcept;
+		void buildSupportedDevicesTable(void);
+		const bool detectSupportedDevice(struct udev_device * pDevice);
+
 		void searchSupportedDevices(struct udev * pUdev);
+#if GKSIMUSB
+		void searchSimulatedDevices(void);
+#endif
 		void initializeDevices(const bool openDevices) noexcept;
-		void checkInitializedDevicesThreadsStatus(void) noexcept;
+		void handleDevicesFailures(void) noexcept;
+
+		const DeviceEntry* findInitializedDevice(const std::string & devID) const;
+		void runDevicesJobs(
+			DevicesJobs_type & jobs,
+			const std::function<void(DeviceJob &)> & jobFunction
+		) noexcept;
+		const std::vector<std::string> startDevices(const std::vector<std::string> & devIDs);
+		const std::vector<std::string> stopDevices(
+			const std::vector<std::string> & devIDs,
+			const bool skipUSBRequests
+		);
 
-		void checkForUnpluggedDevices(void) noexcept;
+		void checkForUnpluggedDevice(struct udev_device * pDevice) noexcept;
 };
 
 } // namespace GLogiK
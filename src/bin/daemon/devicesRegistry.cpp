@@ -0,0 +1,135 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <utility>
+
+#include "lib/utils/utils.hpp"
+
+#include "devicesRegistry.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+const DeviceHandle_type DevicesRegistry::addDevice(
+	USBDeviceID && device,
+	KeyboardDriver* pDriver,
+	const DeviceState state)
+{
+	GK_LOG_FUNC
+
+	DeviceHandle_type handle = 0;
+
+	auto it = _handles.find(device.getID());
+	if( it != _handles.end() ) {
+		handle = (*it).second;
+	}
+	else if( ! _freeHandles.empty() ) {
+		handle = _freeHandles.back();
+		_freeHandles.pop_back();
+	}
+	else {
+		if( _devices.size() > UINT16_MAX )
+			throw GLogiKExcept("devices registry full");
+
+		handle = static_cast<DeviceHandle_type>( _devices.size() );
+		_devices.emplace_back();
+	}
+
+	DeviceEntry & entry = _devices[handle];
+	entry.device = std::move(device);
+	entry.pDriver = pDriver;
+	entry.state = state;
+	entry.handle = handle;
+
+	_handles[entry.device.getID()] = handle;
+
+	GKLog4(trace, entry.device.getID(), " registered device", "handle : ", handle)
+
+	return handle;
+}
+
+void DevicesRegistry::removeDevice(const DeviceHandle_type handle)
+{
+	DeviceEntry & entry = _devices[handle];
+	if( entry.state == DeviceState::DEVICE_NONE )
+		return;
+
+	_handles.erase(entry.device.getID());
+
+	entry.pDriver = nullptr;
+	entry.state = DeviceState::DEVICE_NONE;
+
+	_freeHandles.push_back(handle);
+}
+
+DeviceEntry* DevicesRegistry::findDevice(const std::string & devID)
+{
+	auto it = _handles.find(devID);
+	if( it == _handles.end() )
+		return nullptr;
+
+	return &_devices[(*it).second];
+}
+
+const DeviceEntry* DevicesRegistry::findDevice(const std::string & devID) const
+{
+	auto it = _handles.find(devID);
+	if( it == _handles.end() )
+		return nullptr;
+
+	return &_devices[(*it).second];
+}
+
+const std::vector<DeviceHandle_type> DevicesRegistry::getDevices(const DeviceState state) const
+{
+	std::vector<DeviceHandle_type> ret;
+
+	for(std::size_t i = 0; i < _devices.size(); ++i) {
+		if( _devices[i].state == state )
+			ret.push_back( static_cast<DeviceHandle_type>(i) );
+	}
+
+	return ret;
+}
+
+const std::vector<std::string> DevicesRegistry::getDevicesIDs(const DeviceState state) const
+{
+	std::vector<std::string> ret;
+
+	for(const auto & entry : _devices) {
+		if( entry.state == state )
+			ret.push_back( entry.device.getID() );
+	}
+
+	return ret;
+}
+
+void DevicesRegistry::clear(void)
+{
+	_devices.clear();
+	_freeHandles.clear();
+	_handles.clear();
+}
+
+} // namespace GLogiK
+
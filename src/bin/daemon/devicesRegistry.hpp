@@ -0,0 +1,102 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_BIN_DAEMON_DEVICES_REGISTRY_HPP_
+#define SRC_BIN_DAEMON_DEVICES_REGISTRY_HPP_
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+#include "keyboardDriver.hpp"
+
+#include "USBDeviceID.hpp"
+
+namespace GLogiK
+{
+
+enum class DeviceState : uint8_t
+{
+	DEVICE_NONE = 0,	/* free registry slot */
+	DEVICE_DETECTED,
+	DEVICE_STARTED,
+	DEVICE_STOPPED,
+	DEVICE_SUSPENDED,	/* opened, threads stopped during sleep */
+	DEVICE_UNPLUGGED,
+};
+
+typedef uint16_t DeviceHandle_type;
+
+struct DeviceEntry
+{
+	USBDeviceID device;
+	KeyboardDriver* pDriver = nullptr;
+	DeviceState state = DeviceState::DEVICE_NONE;
+	DeviceHandle_type handle = 0;
+};
+
+/*
+ * Devices known by the DevicesManager, each one stored in a slot
+ * of a table and identified by its slot index (handle).
+ * Device string IDs are only used to find the handle, once per request.
+ * Slots are appended to a deque and reused, never moved, so pointers
+ * and references to entries stay valid until the registry is cleared,
+ * and may be handed to the DevicesManager workers.
+ */
+class DevicesRegistry
+{
+	public:
+		DevicesRegistry(void) = default;
+		~DevicesRegistry(void) = default;
+
+		/* replaces any device with the same ID */
+		const DeviceHandle_type addDevice(
+			USBDeviceID && device,
+			KeyboardDriver* pDriver,
+			const DeviceState state
+		);
+		void removeDevice(const DeviceHandle_type handle);
+
+		/* return nullptr if not found */
+		DeviceEntry* findDevice(const std::string & devID);
+		const DeviceEntry* findDevice(const std::string & devID) const;
+
+		DeviceEntry & getDevice(const DeviceHandle_type handle) { return _devices[handle]; }
+
+		const std::vector<DeviceHandle_type> getDevices(const DeviceState state) const;
+		const std::vector<std::string> getDevicesIDs(const DeviceState state) const;
+
+		void clear(void);
+
+	protected:
+
+	private:
+		std::deque<DeviceEntry> _devices;
+		std::vector<DeviceHandle_type> _freeHandles;
+		std::unordered_map<std::string, DeviceHandle_type> _handles;
+};
+
+} // namespace GLogiK
+
+#endif
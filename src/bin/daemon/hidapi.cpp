@@ -21,6 +21,9 @@
 
 #include <sstream>
 #include <iomanip>
+#include <mutex>
+#include <set>
+#include <string>
 
 #include "lib/utils/utils.hpp"
 
@@ -34,6 +37,9 @@ namespace GLogiK
 
 using namespace NSGKUtils;
 
+std::mutex hidapi::_openMutex;
+std::set<std::string> hidapi::_openedPaths;
+
 hidapi::hidapi()
 {
 	GK_LOG_FUNC
@@ -101,9 +107,27 @@ void hidapi::openUSBDevice(USBDevice & device)
 		return os.str();
 	};
 
+	/* devices may be opened concurrently, hid_enumerate() and hid_open_path()
+	 * are not guaranteed to be thread-safe, and the path lookup may use
+	 * the shared libusb context */
+	std::lock_guard<std::mutex> lock(hidapi::_openMutex);
+
 	const std::string searchedPath(make_hidapi_path());
 	GKLog2(trace, "searched path : ", searchedPath)
 
+	/* path already opened once, skip enumeration */
+	if( _openedPaths.count(searchedPath) > 0 ) {
+		device._pHIDDevice = hid_open_path(searchedPath.c_str());
+
+		if(device._pHIDDevice != nullptr) {
+			GKLog2(trace, device.getID(), " opened HIDAPI USB device, known path")
+			return;
+		}
+
+		/* device may have been replugged elsewhere, fallback to enumeration */
+		_openedPaths.erase(searchedPath);
+	}
+
 	/* getVendorID() and getProductID() return strings in hexadecimal format */
 	const unsigned short vendor_id  = toUShort( device.getVendorID(),  16 );
 	const unsigned short product_id = toUShort( device.getProductID(), 16 );
@@ -147,6 +171,8 @@ void hidapi::openUSBDevice(USBDevice & device)
 	if(device._pHIDDevice == nullptr) {
 		throw GLogiKExcept("device not found by hidapi enumerate");
 	}
+
+	_openedPaths.insert(searchedPath);
 }
 
 void hidapi::closeUSBDevice(USBDevice & device) noexcept
@@ -252,6 +278,29 @@ int hidapi::performUSBDeviceLCDScreenInterruptTransfer(
 	return 0;
 }
 
+/*
+ * hidapi does not provide any way to cancel a pending read or write,
+ * keys reads are short enough (10ms), nothing to do here
+ */
+void hidapi::cancelUSBDeviceTransfers(USBDevice & device) noexcept
+{
+}
+
+/* hidapi has no way to send a standard request, the manufacturer
+ * string lookup fails if the device is gone */
+const bool hidapi::checkUSBDevice(USBDevice & device) noexcept
+{
+	GK_LOG_FUNC
+
+	wchar_t manufacturer[128];
+	if( hid_get_manufacturer_string(device._pHIDDevice, manufacturer, 128) == -1 ) {
+		this->logUSBDeviceHIDError(device._pHIDDevice);
+		return false;
+	}
+
+	return true;
+}
+
 void hidapi::logUSBDeviceHIDError(hid_device *dev) noexcept
 {
 	GK_LOG_FUNC
@@ -25,6 +25,8 @@
 #include <cstdint>
 
 #include <string>
+#include <mutex>
+#include <set>
 
 #include "USBDevice.hpp"
 
@@ -63,7 +65,13 @@ class hidapi
 			unsigned int timeout
 		);
 
+		void cancelUSBDeviceTransfers(USBDevice & device) noexcept;
+		const bool checkUSBDevice(USBDevice & device) noexcept;
+
 	private:
+		static std::mutex _openMutex;
+		/* paths found by hid_enumerate(), protected by _openMutex */
+		static std::set<std::string> _openedPaths;
 
 		void logUSBDeviceHIDError(hid_device *dev) noexcept;
 
@@ -19,6 +19,9 @@
  *
  */
 
+#include <unistd.h>
+
+#include <cerrno>
 #include <stdexcept>
 #include <new>
 #include <iostream>
@@ -26,6 +29,7 @@
 #include <chrono>
 #include <algorithm>
 #include <sstream>
+#include <memory>
 
 #include "lib/shared/glogik.hpp"
 #include "lib/utils/utils.hpp"
@@ -33,6 +37,7 @@
 #include "keyboardDriver.hpp"
 
 #include "daemonControl.hpp"
+#include "LCDPlugins/systemStatsSampler.hpp"
 #include "USBAPIenums.hpp"
 
 namespace GLogiK
@@ -46,6 +51,7 @@ using namespace NSGKUtils;
  */
 
 constexpr unsigned char KeyboardDriver::hidKeyboard[256];
+constexpr uint64_t KeyboardDriver::MKeysMask;
 
 /* KEY_FOO from linux/input-event-codes.h */
 const std::vector< ModifierKey > KeyboardDriver::modifierKeys = {
@@ -89,17 +95,40 @@ const bool KeyboardDriver::checkDeviceCapability(const USBDeviceID & device, Cap
 	return (device.getCapabilities() & toEnumType(toCheck));
 }
 
+/* counts one key event signal, and records its report, decode
+ * and signal timestamps when latency probes are enabled */
+void KeyboardDriver::markKeyEventSent(
+	USBDevice & device,
+	const LatencyFlow flow) noexcept
+{
+	device._metrics.signalsEmitted++;
+
+	if( ! LatencyProbe::isEnabled() )
+		return;
+
+	LatencyProbe::mark(flow, LatencyStage::STAGE_REPORT, device._reportTimestamp);
+	LatencyProbe::mark(flow, LatencyStage::STAGE_DECODED, device._decodedTimestamp);
+	LatencyProbe::mark(flow, LatencyStage::STAGE_SIGNAL_SENT);
+}
+
 KeyStatus KeyboardDriver::getPressedKeys(USBDevice & device)
 {
 	GK_LOG_FUNC
 
 	std::fill_n(device._pressedKeys, KEYS_BUFFER_LENGTH, 0);
 
-	int ret = this->performUSBDeviceKeysInterruptTransfer(device, 10);
+	int ret = 0;
+	{
+		GKTrace::Scope trace(TraceEventID::TRACE_USB_KEYS_TRANSFER);
+		ret = this->performUSBDeviceKeysInterruptTransfer(device, 10);
+		trace.setArg(ret);
+	}
 
 	switch(ret) {
 		case 0:
+			device._metrics.keysTransfersOk++;
 			if( device.getLastKeysInterruptTransferLength() > 0 ) {
+				device._metrics.keysReports++;
 #if DEBUGGING_ON && DEBUG_KEYS
 				if(GKLogging::GKDebug) {
 					LOG(trace)	<< device.getID()
@@ -108,15 +137,26 @@ KeyStatus KeyboardDriver::getPressedKeys(USBDevice & device)
 								<< " xBuf[0]: " << std::hex << toUInt(device._pressedKeys[0]);
 				}
 #endif
-				return this->processKeyEvent(device);
+				GKTrace::Scope trace(TraceEventID::TRACE_KEY_DECODE);
+
+				if( ! LatencyProbe::isEnabled() )
+					return this->processKeyEvent(device);
+
+				device._reportTimestamp = LatencyProbe::now();
+				const KeyStatus status = this->processKeyEvent(device);
+				device._decodedTimestamp = LatencyProbe::now();
+				return status;
 			}
 			break;
 		case toEnumType(USBAPIKeysTransferStatus::TRANSFER_TIMEOUT):
 			//GKLog(trace, "timeout reached")
+			device._metrics.keysTransfersTimeout++;
 			return KeyStatus::S_KEY_TIMEDOUT;
 			break;
 		default:
 			GKSysLogError(device.getID(), " interrupt read error");
+			device._metrics.keysTransfersError++;
+			device._metrics.fatalErrors++;
 			device._fatalErrors++;
 			return KeyStatus::S_KEY_SKIPPED;
 			break;
@@ -182,17 +222,22 @@ const bool KeyboardDriver::updateDeviceMxKeysLedsMask(USBDevice & device, bool d
 		mask_updated = true;
 	};
 
-	/* M1 key was pressed */
-	if( device._pressedRKeysMask & toEnumType(Keys::GK_KEY_M1) ) {
-		update_MxKey_mask(Leds::GK_LED_M1, MKeysID::MKEY_M1);
-	}
-	/* M2 key was pressed */
-	else if( device._pressedRKeysMask & toEnumType(Keys::GK_KEY_M2) ) {
-		update_MxKey_mask(Leds::GK_LED_M2, MKeysID::MKEY_M2);
-	}
-	/* M3 key was pressed */
-	else if( device._pressedRKeysMask & toEnumType(Keys::GK_KEY_M3) ) {
-		update_MxKey_mask(Leds::GK_LED_M3, MKeysID::MKEY_M3);
+	/* an Mx key was pressed, the lowest one wins */
+	const uint64_t MKeys = device._pressedRKeysMask & KeyboardDriver::MKeysMask;
+	if( MKeys != 0 ) {
+		switch( getFirstRKey(MKeys) ) {
+			case Keys::GK_KEY_M1:
+				update_MxKey_mask(Leds::GK_LED_M1, MKeysID::MKEY_M1);
+				break;
+			case Keys::GK_KEY_M2:
+				update_MxKey_mask(Leds::GK_LED_M2, MKeysID::MKEY_M2);
+				break;
+			case Keys::GK_KEY_M3:
+				update_MxKey_mask(Leds::GK_LED_M3, MKeysID::MKEY_M3);
+				break;
+			default:
+				break;
+		}
 	}
 
 #if GKDBUS
@@ -210,6 +255,8 @@ const bool KeyboardDriver::updateDeviceMxKeysLedsMask(USBDevice & device, bool d
 
 			_pDBus->sendBroadcastSignal();
 
+			this->markKeyEventSent(device, LatencyFlow::LATENCY_MKEY);
+
 			LOG(trace)	<< device.getID() << " sent DBus signal: DeviceMBankSwitch - M"
 						<< pressed_MKey;
 		}
@@ -402,18 +449,44 @@ void KeyboardDriver::fillStandardKeysEvents(USBDevice & device)
 	}
 }
 
-void KeyboardDriver::checkDeviceFatalErrors(USBDevice & device, const std::string & place) const
+void KeyboardDriver::checkDeviceFatalErrors(USBDevice & device, const std::string & place)
 {
 	GK_LOG_FUNC
 
 	/* check to give up */
 	if(device._fatalErrors > DEVICE_LISTENING_THREAD_MAX_ERRORS) {
+		/* both device threads may reach this point */
+		if( ! device.getThreadsStatus() )
+			return;
+
 		std::ostringstream err(device.getID(), std::ios_base::app);
 		err << "[" << place << "]" << " device " << device.getFullName()
 			<< " on bus " << toUInt(device.getBus());
 		GKSysLogError(err.str());
 		GKSysLogError("reached listening thread maximum fatal errors, giving up");
 		device.stopThreads();
+		this->notifyDeviceFailure(device.getID());
+	}
+}
+
+/* called from device threads, wakes up the DevicesManager main loop */
+void KeyboardDriver::notifyDeviceFailure(const std::string & devID) noexcept
+{
+	GK_LOG_FUNC
+
+	{
+		std::lock_guard<std::mutex> lock(_failedDevicesMutex);
+		_failedDevices.push_back(devID);
+	}
+
+	if(_devicesEventFD < 0) {
+		GKSysLogWarning("devices event file descriptor not set");
+		return;
+	}
+
+	const uint64_t event = 1;
+	if( write(_devicesEventFD, &event, sizeof(event)) != sizeof(event) ) {
+		GKSysLogError("devices event write failure : ", getErrnoString(errno));
 	}
 }
 
@@ -489,6 +562,8 @@ void KeyboardDriver::enterMacroRecordMode(USBDevice & device)
 
 					_pDBus->sendBroadcastSignal();
 
+					this->markKeyEventSent(device, LatencyFlow::LATENCY_MACRO_RECORD);
+
 					LOG(trace)	<< device.getID() << " sent DBus signal: "
 								<< signal << " - " << getGKeyName(device._GKeyID);
 				}
@@ -516,60 +591,101 @@ void KeyboardDriver::LCDScreenLoop(const std::string & devID)
 {
 	GK_LOG_FUNC
 
+	/* system stats are only sampled while a plugin displaying them is enabled */
+	const uint64_t statsPlugins =
+		toEnumType(LCDScreenPlugin::GK_LCD_SYSTEM_MONITOR) |
+		toEnumType(LCDScreenPlugin::GK_LCD_CORETEMP);
+	bool samplerStarted = false;
+
 	try {
-		USBDevice & device = _initializedDevices.at(devID);
-		device._LCDThreadID = std::this_thread::get_id();
+		USBDevice & device = this->getInitializedDevice(devID);
 
 		GKLog3(trace, devID, " spawned LCD screen thread for ", device.getFullName())
 
+		/*
+		 * Frames are scheduled on absolute deadlines, so that render and
+		 * transfer durations don't shift the next frames. Frames rendered
+		 * earlier on LCD key presses don't move the current deadline.
+		 */
+		auto deadline = std::chrono::steady_clock::now();
+
 		while( DaemonControl::isDaemonRunning() ) {
 			this->checkDeviceFatalErrors(device, "LCD screen loop");
 			if( ! device.getThreadsStatus() )
 				break;
 
-			auto t1 = std::chrono::high_resolution_clock::now();
+			device._metrics.LCDThreadWakeups++;
 
-			std::string LCDKey;
-			uint64_t LCDPluginsMask1 = 0;
+			const uint64_t LCDPluginsMask1 = device._LCDPluginsMask1.load(std::memory_order_relaxed);
+			/* one key per frame, remaining ones wake up the next wait */
+			const uint64_t LCDKey = device.popLCDKey();
 
-			{
-				yield_for(std::chrono::microseconds(100));
-				std::lock_guard<std::mutex> lock(device._LCDMutex);
-				if( ! device._LCDKey.empty() ) {
-					LCDKey = device._LCDKey;
-					device._LCDKey.clear();
-				}
-				LCDPluginsMask1 = device._LCDPluginsMask1;
+			const bool statsNeeded = ((LCDPluginsMask1 & statsPlugins) != 0);
+			if( statsNeeded and (! samplerStarted) ) {
+				samplerStarted = SystemStatsSampler::start();
 			}
+			else if( (! statsNeeded) and samplerStarted ) {
+				SystemStatsSampler::stop();
+				samplerStarted = false;
+			}
+
+			auto renderStart = std::chrono::steady_clock::now();
 
+			GKTrace::record(TraceEventID::TRACE_LCD_RENDER, TracePhase::TRACE_BEGIN);
 			const PixelsData & LCDBuffer = device.getLCDPluginsManager()->getNextLCDScreenBuffer(LCDKey, LCDPluginsMask1);
+			GKTrace::record(TraceEventID::TRACE_LCD_RENDER, TracePhase::TRACE_END);
+
+			auto transferStart = std::chrono::steady_clock::now();
+			device._metrics.LCDRenderTime.add(transferStart - renderStart);
+			device._metrics.LCDFramesRendered++;
+
+			GKTrace::record(TraceEventID::TRACE_USB_LCD_TRANSFER, TracePhase::TRACE_BEGIN);
 			int ret = this->performUSBDeviceLCDScreenInterruptTransfer(
 				device,
 				LCDBuffer.data(),
 				LCDBuffer.size(),
 				1000
 			);
-
-			auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1);
-			auto one = std::chrono::milliseconds( device.getLCDPluginsManager()->getPluginTiming() );
+			GKTrace::record(TraceEventID::TRACE_USB_LCD_TRANSFER, TracePhase::TRACE_END, ret);
+
+			device._metrics.LCDTransferTime.add(std::chrono::steady_clock::now() - transferStart);
+			if(ret == 0)
+				device._metrics.LCDFramesPushed++;
+			else
+				device._metrics.LCDFramesSkipped++;
+
+			const auto period = std::chrono::milliseconds( device.getLCDPluginsManager()->getPluginTiming() );
+			const auto now = std::chrono::steady_clock::now();
+
+			if( now >= deadline ) {
+				deadline += period;
+				if( now >= deadline ) {
+					/* skip missed frames instead of rendering them in a burst */
+					const uint64_t missed = ((now - deadline) / period) + 1;
+					deadline += missed * period;
+
+					device.getLCDPluginsManager()->reportMissedDeadlines(missed);
+					device._metrics.LCDMissedDeadlines += missed;
+				}
+			}
 
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
 			if(GKLogging::GKDebug) {
 				LOG(trace)	<< devID << " refreshed LCD screen for "
 							<< device.getFullName()
 							<< " - ret: " << ret
-							<< " - interval: " << interval.count()
-							<< " - next sleep: " << one.count();
+							<< " - period: " << period.count()
+							<< " - next deadline in: "
+							<< std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
 			}
 #endif
 			if(ret != 0) { // TODO stop thread ?
 				GKSysLogError("LCD refresh failure");
 			}
 
-			if( interval < one ) {
-				one -= interval;
-				std::this_thread::sleep_for(one);
-			}
+			/* interrupted by ::stopThreads() or by a LCD key press */
+			if( device.waitForLCDKeyOrThreadsStop(deadline) )
+				break;
 		}
 
 		device.getLCDPluginsManager()->unlockPlugin();
@@ -578,7 +694,7 @@ void KeyboardDriver::LCDScreenLoop(const std::string & devID)
 		const uint64_t endscreen = toEnumType(LCDScreenPlugin::GK_LCD_ENDSCREEN);
 		/* make sure endscreen plugin is loaded before using it */
 		if( device.getLCDPluginsManager()->findOneLCDScreenPlugin( endscreen ) ) {
-			const PixelsData & LCDBuffer = device.getLCDPluginsManager()->getNextLCDScreenBuffer("", endscreen);
+			const PixelsData & LCDBuffer = device.getLCDPluginsManager()->getNextLCDScreenBuffer(0, endscreen);
 			int ret = this->performUSBDeviceLCDScreenInterruptTransfer(
 				device,
 				LCDBuffer.data(),
@@ -604,6 +720,9 @@ void KeyboardDriver::LCDScreenLoop(const std::string & devID)
 	catch( const std::exception & e ) {
 		GKSysLogError("uncaught std::exception : ", e.what());
 	}
+
+	if( samplerStarted )
+		SystemStatsSampler::stop();
 }
 
 void KeyboardDriver::listenLoop(const std::string & devID)
@@ -611,8 +730,7 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 	GK_LOG_FUNC
 
 	try {
-		USBDevice & device = _initializedDevices.at(devID);
-		device._keysThreadID = std::this_thread::get_id();
+		USBDevice & device = this->getInitializedDevice(devID);
 
 		GKLog3(trace, devID, " spawned listening thread for ", device.getFullName())
 
@@ -621,6 +739,8 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 			if( ! device.getThreadsStatus() )
 				break;
 
+			device._metrics.keysThreadWakeups++;
+
 			KeyStatus ret = this->getPressedKeys(device);
 			switch( ret ) {
 				case KeyStatus::S_KEY_PROCESSED:
@@ -662,6 +782,8 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 
 										_pDBus->sendBroadcastSignal();
 
+										this->markKeyEventSent(device, LatencyFlow::LATENCY_GKEY);
+
 										LOG(trace)	<< device.getID() << " sent DBus signal: DeviceGKeyEvent - "
 													<< getGKeyName(device._GKeyID);
 									}
@@ -689,7 +811,7 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 					if( this->checkDeviceCapability(device, Caps::GK_MEDIA_KEYS) ) {
 						if( device.getLastKeysInterruptTransferLength() == device.getMediaKeysTransferLength() ) {
 							if( this->checkMediaKey(device) ) {
-								LOG(trace) << device.getID() << " media key pressed: " << device._mediaKey;
+								LOG(trace) << device.getID() << " media key pressed: " << getKeyName(static_cast<Keys>(device._mediaKey));
 #if GKDBUS
 								try {
 									_pDBus->initializeBroadcastSignal(
@@ -700,12 +822,15 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 									);
 
 									_pDBus->appendStringToBroadcastSignal(devID);
-									_pDBus->appendStringToBroadcastSignal(device._mediaKey);
+									/* key name is only built here, for the D-Bus signal */
+									_pDBus->appendStringToBroadcastSignal( getKeyName(static_cast<Keys>(device._mediaKey)) );
 
 									_pDBus->sendBroadcastSignal();
 
+									this->markKeyEventSent(device, LatencyFlow::LATENCY_MEDIA);
+
 									LOG(trace)	<< devID << " sent DBus signal: DeviceMediaEvent - "
-												<< device._mediaKey;
+												<< getKeyName(static_cast<Keys>(device._mediaKey));
 								}
 								catch (const GKDBusMessageWrongBuild & e) {
 									_pDBus->abandonBroadcastSignal();
@@ -720,8 +845,7 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 						if( device.getLastKeysInterruptTransferLength() == device.getLCDKeysTransferLength() ) {
 							if( this->checkLCDKey(device) ) {
 #if DEBUGGING_ON && DEBUG_LCD_PLUGINS
-								std::lock_guard<std::mutex> lock(device._LCDMutex);
-								GKLog3(trace, devID, " LCD key pressed : ", device._LCDKey)
+								GKLog3(trace, devID, " LCD key pressed : ", getKeyName(static_cast<Keys>(device._LCDKey)))
 #endif
 							}
 						}
@@ -745,18 +869,20 @@ void KeyboardDriver::listenLoop(const std::string & devID)
 	}
 }
 
-const bool KeyboardDriver::getDeviceThreadsStatus(const std::string & devID) const
+void KeyboardDriver::setDevicesEventFD(const int fd) noexcept
 {
-	GK_LOG_FUNC
+	_devicesEventFD = fd;
+}
 
-	try {
-		return _initializedDevices.at(devID).getThreadsStatus();
-	} /* try */
-	catch (const std::out_of_range& oor) {
-		GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
+/* returns and forgets the devices reported by ::notifyDeviceFailure() */
+const std::vector<std::string> KeyboardDriver::getFailedDevices(void)
+{
+	std::vector<std::string> ret;
+	{
+		std::lock_guard<std::mutex> lock(_failedDevicesMutex);
+		ret.swap(_failedDevices);
 	}
-
-	return false;
+	return ret;
 }
 
 void KeyboardDriver::resetDeviceState(USBDevice & device)
@@ -792,7 +918,7 @@ void KeyboardDriver::resetDeviceState(const USBDeviceID & det)
 	GK_LOG_FUNC
 
 	try {
-		USBDevice & device = _initializedDevices.at(det.getID());
+		USBDevice & device = this->getInitializedDevice(det.getID());
 		this->resetDeviceState(device);
 	}
 	catch (const std::out_of_range& oor) {
@@ -812,11 +938,7 @@ void KeyboardDriver::setDeviceLCDPluginsMask(USBDevice & device, uint64_t mask)
 
 	GKLog3(trace, device.getID(), " setting device LCD plugins mask to : ", mask)
 
-	{
-		yield_for(std::chrono::microseconds(100));
-		std::lock_guard<std::mutex> lock(device._LCDMutex);
-		device._LCDPluginsMask1 = mask;
-	}
+	device._LCDPluginsMask1.store(mask, std::memory_order_relaxed);
 
 	/* Current active plugin may be locked */
 	device.getLCDPluginsManager()->unlockPlugin();
@@ -831,16 +953,32 @@ void KeyboardDriver::joinDeviceThreads(USBDevice & device)
 {
 	GK_LOG_FUNC
 
+#if DEBUGGING_ON
+	const auto t1 = std::chrono::steady_clock::now();
+#endif
+
+	/* wake up sleeping threads, and cancel pending transfers */
 	device.stopThreads();
+	this->cancelUSBDeviceTransfers(device);
+
+	/* threads already joined, suspended device */
+	if( (device._keysThreadID == std::thread::id()) and
+		(device._LCDThreadID == std::thread::id()) ) {
+		GKLog2(trace, device.getID(), " no device threads to join")
+		return;
+	}
 
 	bool found = false;
 	std::thread::id thread_id;
+	std::thread deviceThread;
 
-	auto find_thread = [&thread_id, &found] (auto & item) -> const bool {
+	/* the thread is moved out of the container and joined without
+	 * holding the threads mutex, so devices can be closed in parallel */
+	auto find_thread = [&thread_id, &found, &deviceThread] (auto & item) -> const bool {
 		if( thread_id == item.get_id() ) {
 			found = true;
 			GKLog(trace, "thread found !")
-			item.join();
+			deviceThread = std::move(item);
 			return true;
 		}
 		return false;
@@ -857,9 +995,13 @@ void KeyboardDriver::joinDeviceThreads(USBDevice & device)
 		);
 	}
 
-	if(! found) {
+	if(found) {
+		deviceThread.join();
+	}
+	else {
 		GKSysLogWarning("listening thread not found !");
 	}
+	device._keysThreadID = std::thread::id();
 
 	/* Caps::GK_LCD_SCREEN */
 	if( this->checkDeviceCapability(device, Caps::GK_LCD_SCREEN) ) {
@@ -874,9 +1016,48 @@ void KeyboardDriver::joinDeviceThreads(USBDevice & device)
 			);
 		}
 
-		if(! found) {
+		if(found) {
+			deviceThread.join();
+		}
+		else {
 			GKSysLogWarning("LCD screen thread not found !");
 		}
+		device._LCDThreadID = std::thread::id();
+	}
+
+#if DEBUGGING_ON
+	GKLog3(trace, device.getID(), " device threads stopped in (ms) : ",
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t1).count())
+#endif
+}
+
+/*
+ * Threads IDs are set here, before the threads are stored,
+ * so that ::joinDeviceThreads() always finds them.
+ * Throws GLogiKExcept on thread spawning failure.
+ */
+void KeyboardDriver::spawnDeviceThreads(USBDevice & device)
+{
+	GK_LOG_FUNC
+
+	try {
+		if( this->checkDeviceCapability(device, Caps::GK_LCD_SCREEN) ) {
+			std::thread lcd_thread(&KeyboardDriver::LCDScreenLoop, this, device.getID());
+			device._LCDThreadID = lcd_thread.get_id();
+			std::lock_guard<std::mutex> lock(_threadsMutex);
+			_threads.push_back( std::move(lcd_thread) );
+		}
+
+		/* spawn listening thread */
+		std::thread listen_thread(&KeyboardDriver::listenLoop, this, device.getID() );
+		device._keysThreadID = listen_thread.get_id();
+		std::lock_guard<std::mutex> lock(_threadsMutex);
+		_threads.push_back( std::move(listen_thread) );
+	}
+	catch (const std::system_error& e) {
+		std::ostringstream buffer(std::ios_base::app);
+		buffer << "error while spawning thread : " << e.what();
+		throw GLogiKExcept(buffer.str());
 	}
 }
 
@@ -891,7 +1072,7 @@ void KeyboardDriver::setDeviceActiveConfiguration(
 	GK_LOG_FUNC
 
 	try {
-		USBDevice & device = _initializedDevices.at(devID);
+		USBDevice & device = this->getInitializedDevice(devID);
 
 		if( this->checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
 			/* exit MacroRecordMode if necessary */
@@ -918,7 +1099,7 @@ const LCDPPArray_type &
 	GK_LOG_FUNC
 
 	try {
-		const USBDevice & device = _initializedDevices.at(devID);
+		const USBDevice & device = this->getInitializedDevice(devID);
 		return device.getLCDPluginsManager()->getLCDPluginsProperties();
 	}
 	catch (const std::out_of_range& oor) {
@@ -928,6 +1109,36 @@ const LCDPPArray_type &
 	return LCDScreenPluginsManager::_LCDPluginsPropertiesEmptyArray;
 }
 
+const std::vector<std::string>
+	KeyboardDriver::getDeviceMetrics(const std::string & devID) const
+{
+	GK_LOG_FUNC
+
+	try {
+		const USBDevice & device = this->getInitializedDevice(devID);
+		return device._metrics.toStrings();
+	}
+	catch (const std::out_of_range& oor) {
+		GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
+	}
+
+	const std::vector<std::string> ret;
+	return ret;
+}
+
+/*
+ * Devices may be opened and closed concurrently from the DevicesManager
+ * workers. Devices are heap-allocated once and never moved nor copied,
+ * so the returned reference stays valid while the device is initialized,
+ * only the lookup is locked.
+ * Throws std::out_of_range if device is not initialized.
+ */
+USBDevice & KeyboardDriver::getInitializedDevice(const std::string & devID) const
+{
+	std::lock_guard<std::mutex> lock(_devicesMutex);
+	return *(_initializedDevices.at(devID));
+}
+
 void KeyboardDriver::initializeDevice(const USBDeviceID & det)
 {
 	GK_LOG_FUNC
@@ -938,34 +1149,42 @@ void KeyboardDriver::initializeDevice(const USBDeviceID & det)
 
 	/* device may already have been initialized
 	 * (before DevicesManager startMonitoring() main loop) */
-	if(_initializedDevices.count(devID) > 0) {
-		std::ostringstream buffer(std::ios_base::app);
-		buffer << devID << " device already initialized";
-		GKSysLogInfo(buffer.str());
-		return;
+	{
+		std::lock_guard<std::mutex> lock(_devicesMutex);
+		if(_initializedDevices.count(devID) > 0) {
+			std::ostringstream buffer(std::ios_base::app);
+			buffer << devID << " device already initialized";
+			GKSysLogInfo(buffer.str());
+			return;
+		}
 	}
 
-	USBDevice device(det);
+	std::unique_ptr<USBDevice> pDevice;
 
-	// FIXME
-	//if( this->checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
-	//}
+	try {
+		pDevice = std::make_unique<USBDevice>(det);
 
-	if( this->checkDeviceCapability(device, Caps::GK_LCD_SCREEN) ) {
-		/* plugins manager pointer is required in ->getDeviceLCDPluginsProperties()
-		 * for all initialized devices (even for the stopped ones) */
-		try {
-			device.setLCDPluginsManager( new LCDScreenPluginsManager(device.getProduct()) );
-		}
-		catch (const std::bad_alloc& e) { /* handle new() failure */
-			std::ostringstream buffer(std::ios_base::app);
-			buffer << devID << " LCD Plugins manager allocation failure";
-			GKSysLogError(buffer.str());
-			return;
+		// FIXME
+		//if( this->checkDeviceCapability(*pDevice, Caps::GK_MACROS_KEYS) ) {
+		//}
+
+		if( this->checkDeviceCapability(*pDevice, Caps::GK_LCD_SCREEN) ) {
+			/* plugins manager pointer is required in ->getDeviceLCDPluginsProperties()
+			 * for all initialized devices (even for the stopped ones) */
+			pDevice->setLCDPluginsManager( new LCDScreenPluginsManager(pDevice->getProduct()) );
 		}
 	}
+	catch (const std::bad_alloc& e) { /* handle new() failure */
+		std::ostringstream buffer(std::ios_base::app);
+		buffer << devID << " device or LCD Plugins manager allocation failure";
+		GKSysLogError(buffer.str());
+		return;
+	}
 
-	_initializedDevices[ device.getID() ] = device;
+	{
+		std::lock_guard<std::mutex> lock(_devicesMutex);
+		_initializedDevices.emplace(devID, std::move(pDevice));
+	}
 
 	GKLog2(trace, devID, " device initialized")
 }
@@ -978,7 +1197,7 @@ void KeyboardDriver::openDevice(const USBDeviceID & det)
 	const std::string & devID = det.getID();
 
 	try {
-		USBDevice & device = _initializedDevices.at(devID);
+		USBDevice & device = this->getInitializedDevice(devID);
 
 		this->openUSBDevice(device); /* throws on any failure */
 		/* libusb/hidapi device opened */
@@ -994,22 +1213,11 @@ void KeyboardDriver::openDevice(const USBDeviceID & det)
 		}
 
 		try {
-			if( this->checkDeviceCapability(device, Caps::GK_LCD_SCREEN) ) {
-				std::thread lcd_thread(&KeyboardDriver::LCDScreenLoop, this, device.getID());
-				std::lock_guard<std::mutex> lock(_threadsMutex);
-				_threads.push_back( std::move(lcd_thread) );
-			}
-
-			/* spawn listening thread */
-			std::thread listen_thread(&KeyboardDriver::listenLoop, this, device.getID() );
-			std::lock_guard<std::mutex> lock(_threadsMutex);
-			_threads.push_back( std::move(listen_thread) );
+			this->spawnDeviceThreads(device);
 		}
-		catch (const std::system_error& e) {
-			std::ostringstream buffer(std::ios_base::app);
-			buffer << "error while spawning thread : " << e.what();
+		catch ( const GLogiKExcept & e ) {
 			this->closeDevice(det);
-			throw GLogiKExcept(buffer.str());
+			throw;
 		}
 	}
 	catch (const std::out_of_range& oor) {
@@ -1029,7 +1237,7 @@ void KeyboardDriver::closeDevice(
 	GKLog3(trace, devID, " closing device : ", det.getFullName())
 
 	try {
-		USBDevice & device = _initializedDevices.at(devID);
+		USBDevice & device = this->getInitializedDevice(devID);
 
 		if(skipUSBRequests)
 			device.skipUSBRequests();
@@ -1038,6 +1246,7 @@ void KeyboardDriver::closeDevice(
 		this->resetDeviceState(device);
 		this->closeUSBDevice(device);
 
+		std::lock_guard<std::mutex> lock(_devicesMutex);
 		_initializedDevices.erase(devID);
 	}
 	catch (const std::out_of_range& oor) {
@@ -1045,5 +1254,73 @@ void KeyboardDriver::closeDevice(
 	}
 }
 
+/*
+ * Suspend fast path : device threads are stopped, but the USB
+ * device stays opened with its interface claimed, and the LCD
+ * plugins manager is kept for ::resumeDevice().
+ */
+void KeyboardDriver::suspendDevice(const USBDeviceID & det) noexcept
+{
+	GK_LOG_FUNC
+
+	const std::string & devID = det.getID();
+
+	GKLog3(trace, devID, " suspending device : ", det.getFullName())
+
+	try {
+		USBDevice & device = this->getInitializedDevice(devID);
+		this->joinDeviceThreads(device);
+	}
+	catch (const std::out_of_range& oor) {
+		GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
+	}
+}
+
+/*
+ * Resumes a suspended device in place if it still answers on its
+ * USB handle. Otherwise the device is closed and false is returned,
+ * the caller must then open it again.
+ */
+const bool KeyboardDriver::resumeDevice(const USBDeviceID & det) noexcept
+{
+	GK_LOG_FUNC
+
+	const std::string & devID = det.getID();
+
+	GKLog3(trace, devID, " resuming device : ", det.getFullName())
+
+	try {
+		USBDevice & device = this->getInitializedDevice(devID);
+
+		if( this->checkUSBDevice(device) ) {
+			try {
+				device.restartThreads();
+
+				/* device state may have been lost while powered down */
+				this->sendUSBDeviceInitialization(device);
+				this->resetDeviceState(device);
+
+				this->spawnDeviceThreads(device);
+
+				GKLog2(trace, devID, " device resumed")
+				return true;
+			}
+			catch ( const GLogiKExcept & e ) {
+				GKSysLogError("device resume failure : ", e.what());
+			}
+		}
+		else {
+			GKSysLogWarning("device did not survive suspend, closing it : ", devID);
+		}
+	}
+	catch (const std::out_of_range& oor) {
+		GKSysLogError(CONST_STRING_UNKNOWN_DEVICE, devID);
+		return false;
+	}
+
+	this->closeDevice(det, true);
+	return false;
+}
+
 } // namespace GLogiK
 
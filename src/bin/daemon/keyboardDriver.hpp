@@ -29,6 +29,7 @@
 #include <map>
 #include <thread>
 #include <mutex>
+#include <memory>
 
 #include <linux/input-event-codes.h>
 
@@ -39,8 +40,11 @@
 #include "lib/shared/GKeysMacro.hpp"
 #endif
 
+#include "lib/utils/utils.hpp"
+
 #include "USBDeviceID.hpp"
 #include "USBDevice.hpp"
+#include "RKeys.hpp"
 
 #include "include/enums.hpp"
 #include "include/base.hpp"
@@ -93,7 +97,8 @@ class KeyboardDriver
 		static const bool checkDeviceCapability(const USBDeviceID & device, Caps toCheck);
 
 		/* --- */
-		const bool getDeviceThreadsStatus(const std::string & devID) const;
+		void setDevicesEventFD(const int fd) noexcept;
+		const std::vector<std::string> getFailedDevices(void);
 
 		void resetDeviceState(const USBDeviceID & det);
 
@@ -107,6 +112,9 @@ class KeyboardDriver
 		const LCDPPArray_type & getDeviceLCDPluginsProperties(
 			const std::string & devID
 		) const;
+		const std::vector<std::string> getDeviceMetrics(
+			const std::string & devID
+		) const;
 
 		/* --- */
 		virtual const uint16_t getDriverID() const = 0;
@@ -117,6 +125,8 @@ class KeyboardDriver
 			const USBDeviceID & det,
 			const bool skipUSBRequests = false
 		) noexcept;
+		virtual void suspendDevice(const USBDeviceID & det) noexcept;
+		virtual const bool resumeDevice(const USBDeviceID & det) noexcept;
 
 		virtual const std::vector<USBDeviceID> & getSupportedDevices(void) const = 0;
 		virtual const MKeysIDArray_type getMKeysIDArray(void) const = 0;
@@ -154,9 +164,13 @@ class KeyboardDriver
 		};
 
 		std::mutex _threadsMutex;
+		/* protects _initializedDevices insertions, erasures and lookups */
+		mutable std::mutex _devicesMutex;
 
 		std::vector<std::thread> _threads;
-		std::map<std::string, USBDevice> _initializedDevices;
+		/* devices are never copied, their addresses stay stable
+		 * while device threads are running */
+		std::map<std::string, std::unique_ptr<USBDevice>> _initializedDevices;
 
 #if DEBUGGING_ON && DEBUG_KEYS
 		const std::string getBytes(const USBDevice & device) const;
@@ -164,6 +178,8 @@ class KeyboardDriver
 
 		void fillStandardKeysEvents(USBDevice & device);
 
+		USBDevice & getInitializedDevice(const std::string & devID) const;
+
 	private:
 #if GKDBUS
 		const NSGKDBus::BusConnection & _systemBus = NSGKDBus::GKDBus::SystemBus;
@@ -184,9 +200,21 @@ class KeyboardDriver
 
 		virtual void openUSBDevice(USBDevice & device) = 0;
 		virtual void closeUSBDevice(USBDevice & device) = 0;
+		virtual void cancelUSBDeviceTransfers(USBDevice & device) = 0;
+		virtual const bool checkUSBDevice(USBDevice & device) = 0;
 		/* --- */
 
 		static const std::vector< ModifierKey > modifierKeys;
+		static constexpr uint64_t MKeysMask =
+			NSGKUtils::toEnumType(Keys::GK_KEY_M1) |
+			NSGKUtils::toEnumType(Keys::GK_KEY_M2) |
+			NSGKUtils::toEnumType(Keys::GK_KEY_M3);
+
+		/* devices which threads gave up, waiting to be stopped */
+		std::mutex _failedDevicesMutex;
+		std::vector<std::string> _failedDevices;
+		/* DevicesManager main loop eventfd */
+		int _devicesEventFD = -1;
 
 #if GKDBUS
 		void enterMacroRecordMode(USBDevice & device);
@@ -199,6 +227,10 @@ class KeyboardDriver
 		void notImplemented(const char* func) const;
 
 		KeyStatus getPressedKeys(USBDevice & device);
+		void markKeyEventSent(
+			USBDevice & device,
+			const NSGKUtils::LatencyFlow flow
+		) noexcept;
 
 		const bool updateDeviceMxKeysLedsMask(USBDevice & device, bool disableMR=false);
 		void setDeviceLCDPluginsMask(USBDevice & device, uint64_t mask = 0);
@@ -206,9 +238,11 @@ class KeyboardDriver
 		uint16_t getTimeLapse(USBDevice & device);
 		const uint8_t handleModifierKeys(USBDevice & device, const uint16_t interval);
 
-		void checkDeviceFatalErrors(USBDevice & device, const std::string & place) const;
+		void checkDeviceFatalErrors(USBDevice & device, const std::string & place);
+		void notifyDeviceFailure(const std::string & devID) noexcept;
 
 		void resetDeviceState(USBDevice & device);
+		void spawnDeviceThreads(USBDevice & device);
 		void joinDeviceThreads(USBDevice & device);
 		/* --- */
 
@@ -271,6 +305,14 @@ class USBKeyboardDriver
 
 			USBAPI::closeUSBDevice(device);
 		}
+
+		void cancelUSBDeviceTransfers(USBDevice & device) override {
+			USBAPI::cancelUSBDeviceTransfers(device);
+		}
+
+		const bool checkUSBDevice(USBDevice & device) override {
+			return USBAPI::checkUSBDevice(device);
+		}
 		/* --- */
 };
 
@@ -25,6 +25,7 @@
  */
 
 #include <bitset>
+#include <algorithm>
 #include <mutex>
 #include <sstream>
 
@@ -37,6 +38,9 @@ namespace GLogiK
 
 using namespace NSGKUtils;
 
+std::mutex libusb::_layoutsMutex;
+std::map<USBDeviceLayoutKey_type, USBDeviceLayout> libusb::_layouts;
+
 /*
  * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
@@ -61,11 +65,23 @@ void libusb::openUSBDevice(USBDevice & device)
 
 	GKLog2(trace, device.getID(), " opened USB device")
 
+	USBDeviceLayoutKey_type key;
+	bool cached = false;
+
 	try {
-		this->setUSBDeviceActiveConfiguration(device);
-		this->findUSBDeviceInterface(device);
+		USBDeviceLayout layout;
+		cached = this->getUSBDeviceLayout(device, key, layout);
+
+		this->setUSBDeviceActiveConfiguration(device, layout);
+		this->claimUSBDeviceInterface(device, layout);
 	}
 	catch ( const GLogiKExcept & e ) {
+		if( cached ) {
+			/* next opening will walk the descriptors again */
+			std::lock_guard<std::mutex> lock(libusb::_layoutsMutex);
+			_layouts.erase(key);
+		}
+
 		this->closeUSBDevice(device);
 		throw;
 	}
@@ -162,16 +178,22 @@ int libusb::performUSBDeviceKeysInterruptTransfer(
 	int ret = 0;
 	{
 		std::lock_guard<std::mutex> lock(device._libUSBMutex);
-		ret = libusb_interrupt_transfer(
-			device._pUSBDeviceHandle,
+		ret = this->performUSBDeviceInterruptTransfer(
+			device,
+			device._pKeysTransfer,
 			device._keysEndpoint,
 			static_cast<unsigned char*>(device._pressedKeys),
 			device.getKeysInterruptBufferMaxLength(),
 			&(device._lastKeysInterruptTransferLength),
-			timeout
+			timeout,
+			true
 		);
 	}
 
+	/* transfer cancelled on device stop, handled as a timeout */
+	if( (ret == LIBUSB_ERROR_INTERRUPTED) and ( ! device.getThreadsStatus() ) )
+		return LIBUSB_ERROR_TIMEOUT;
+
 	if(ret < 0 and ret != LIBUSB_ERROR_TIMEOUT) {
 		this->USBError(ret);
 	}
@@ -198,16 +220,24 @@ int libusb::performUSBDeviceLCDScreenInterruptTransfer(
 		/* here we assume that buffer will be used read-only by
 		 * interrupt_transfer since _LCDEndpoint direction is OUT
 		 * (host-to-device) */
-		ret = libusb_interrupt_transfer(
-			device._pUSBDeviceHandle,
+		ret = this->performUSBDeviceInterruptTransfer(
+			device,
+			device._pLCDTransfer,
 			device._LCDEndpoint,
 			const_cast<unsigned char *>(buffer),
 			bufferLength,
 			&(device._lastLCDInterruptTransferLength),
-			timeout
+			timeout,
+			false	/* endscreen is sent once threads are stopped */
 		);
 	}
 
+	/* transfer cancelled on device stop */
+	if( (ret == LIBUSB_ERROR_INTERRUPTED) and ( ! device.getThreadsStatus() ) ) {
+		GKLog2(trace, device.getID(), " LCD screen transfer cancelled")
+		return 0;
+	}
+
 #if DEBUGGING_ON && DEBUG_LIBUSB_EXTRA
 	if(GKLogging::GKDebug) {
 		LOG(trace)	<< device.getID()
@@ -223,6 +253,27 @@ int libusb::performUSBDeviceLCDScreenInterruptTransfer(
 	return ret;
 }
 
+/* cancels in-flight interrupt transfers, so that device threads can exit */
+void libusb::cancelUSBDeviceTransfers(USBDevice & device) noexcept
+{
+	GK_LOG_FUNC
+
+	std::lock_guard<std::mutex> lock(device._transfersMutex);
+
+	for(auto pTransfer : {device._pKeysTransfer, device._pLCDTransfer}) {
+		if(pTransfer == nullptr)
+			continue;
+
+		int ret = libusb_cancel_transfer(pTransfer);
+		/* NOT_FOUND : transfer already completed or cancelled */
+		if( (ret < 0) and (ret != LIBUSB_ERROR_NOT_FOUND) ) {
+			this->USBError(ret);
+		}
+	}
+
+	GKLog2(trace, device.getID(), " cancelled in-flight transfers")
+}
+
 /*
  * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
@@ -233,6 +284,148 @@ int libusb::performUSBDeviceLCDScreenInterruptTransfer(
  * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
  */
 
+/*
+ * Cheap standard GET_STATUS request, used to check that the
+ * device handle is still valid after a suspend cycle.
+ */
+const bool libusb::checkUSBDevice(USBDevice & device) noexcept
+{
+	GK_LOG_FUNC
+
+	unsigned char status[2] = {0, 0};
+
+	int ret = 0;
+	{
+		std::lock_guard<std::mutex> lock(device._libUSBMutex);
+		ret = libusb_control_transfer(
+			device._pUSBDeviceHandle,
+			LIBUSB_ENDPOINT_IN|LIBUSB_REQUEST_TYPE_STANDARD|LIBUSB_RECIPIENT_DEVICE,
+			LIBUSB_REQUEST_GET_STATUS,
+			0,                              /* wValue */
+			0,                              /* wIndex - device */
+			status,
+			2,
+			100
+		);
+	}
+	if( ret < 0 ) {
+		this->USBError(ret);
+		return false;
+	}
+
+	GKLog3(trace, device.getID(), " device status request, transferred bytes : ", ret)
+
+	return (ret == 2);
+}
+
+void LIBUSB_CALL libusb::transferCallback(struct libusb_transfer * pTransfer)
+{
+	int* completed = static_cast<int*>(pTransfer->user_data);
+	*completed = 1;
+}
+
+/*
+ * Same as libusb_interrupt_transfer(), but built on the asynchronous
+ * API, so that the in-flight transfer can be cancelled from another
+ * thread with ::cancelUSBDeviceTransfers(). Returns LIBUSB_ERROR_INTERRUPTED
+ * when the transfer was cancelled.
+ * Cancellable transfers are not submitted anymore once device threads are
+ * stopped, since ::cancelUSBDeviceTransfers() may already have run. The
+ * threads status is checked under the transfers mutex, so that a transfer
+ * is either refused here or found and cancelled there.
+ */
+int libusb::performUSBDeviceInterruptTransfer(
+	USBDevice & device,
+	libusb_transfer* & pTransfer,
+	unsigned char endpoint,
+	unsigned char * data,
+	int length,
+	int * transferred,
+	unsigned int timeout,
+	const bool cancellable)
+{
+	struct libusb_transfer * transfer = libusb_alloc_transfer(0);
+	if(transfer == nullptr)
+		return LIBUSB_ERROR_NO_MEM;
+
+	int completed = 0;
+	libusb_fill_interrupt_transfer(
+		transfer,
+		device._pUSBDeviceHandle,
+		endpoint,
+		data,
+		length,
+		libusb::transferCallback,
+		&completed,
+		timeout
+	);
+
+	{
+		std::lock_guard<std::mutex> lock(device._transfersMutex);
+		if( cancellable and ( ! device.getThreadsStatus() ) ) {
+			libusb_free_transfer(transfer);
+			*transferred = 0;
+			return LIBUSB_ERROR_INTERRUPTED;
+		}
+
+		int ret = libusb_submit_transfer(transfer);
+		if(ret < 0) {
+			libusb_free_transfer(transfer);
+			return ret;
+		}
+		pTransfer = transfer;
+	}
+
+	while( ! completed ) {
+		int ret = libusb_handle_events_completed(this->getUSBContext(), &completed);
+		if(ret < 0) {
+			if(ret == LIBUSB_ERROR_INTERRUPTED)
+				continue;
+			libusb_cancel_transfer(transfer);
+			while( ! completed ) {
+				if(libusb_handle_events_completed(this->getUSBContext(), &completed) < 0)
+					break;
+			}
+			break;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(device._transfersMutex);
+		pTransfer = nullptr;
+	}
+
+	*transferred = transfer->actual_length;
+
+	int ret = 0;
+	switch(transfer->status) {
+		case LIBUSB_TRANSFER_COMPLETED:
+			break;
+		case LIBUSB_TRANSFER_TIMED_OUT:
+			ret = LIBUSB_ERROR_TIMEOUT;
+			break;
+		case LIBUSB_TRANSFER_CANCELLED:
+			ret = LIBUSB_ERROR_INTERRUPTED;
+			break;
+		case LIBUSB_TRANSFER_STALL:
+			ret = LIBUSB_ERROR_PIPE;
+			break;
+		case LIBUSB_TRANSFER_NO_DEVICE:
+			ret = LIBUSB_ERROR_NO_DEVICE;
+			break;
+		case LIBUSB_TRANSFER_OVERFLOW:
+			ret = LIBUSB_ERROR_OVERFLOW;
+			break;
+		default:
+			ret = LIBUSB_ERROR_IO;
+			break;
+	}
+
+	libusb_free_transfer(transfer);
+
+	return ret;
+}
+
 void libusb::releaseUSBDeviceInterfaces(USBDevice & device) noexcept
 {
 	GK_LOG_FUNC
@@ -271,7 +464,9 @@ void libusb::releaseUSBDeviceInterfaces(USBDevice & device) noexcept
  *			libusb_set_configuration() may succeed.
  *
  */
-void libusb::setUSBDeviceActiveConfiguration(USBDevice & device)
+void libusb::setUSBDeviceActiveConfiguration(
+	USBDevice & device,
+	const USBDeviceLayout & layout)
 {
 	GK_LOG_FUNC
 
@@ -298,43 +493,9 @@ void libusb::setUSBDeviceActiveConfiguration(USBDevice & device)
 	GKLog2(trace, device.getID(), " will try to set the active configuration to the wanted value")
 
 	/* have to detach all interfaces first */
-
-	libusb_device_descriptor deviceDescriptor;
-	ret = libusb_get_device_descriptor(device._pUSBDevice, &deviceDescriptor);
-	if ( this->USBError(ret) )
-		throw GLogiKExcept("libusb get_device_descriptor failure");
-
-	for(unsigned int i = 0; i < toUInt(deviceDescriptor.bNumConfigurations); i++) {
-		/* configuration descriptor */
-		libusb_config_descriptor * configDescriptor = nullptr;
-		ret = libusb_get_config_descriptor(device._pUSBDevice, i, &configDescriptor);
-		if ( this->USBError(ret) ) {
-			std::ostringstream buffer(std::ios_base::app);
-			buffer << "get_config_descriptor failure with index : " << i;
-			GKSysLogError(buffer.str());
-			continue;
-		}
-
-		for(unsigned int j = 0; j < toUInt(configDescriptor->bNumInterfaces); j++) {
-			const libusb_interface *iface = &(configDescriptor->interface[j]);
-
-			for (unsigned int k = 0; k < toUInt(iface->num_altsetting); k++) {
-				/* interface alt_setting descriptor */
-				const libusb_interface_descriptor * asDescriptor = &(iface->altsetting[k]);
-
-				try {
-					int numInt = toInt(asDescriptor->bInterfaceNumber);
-					this->detachKernelDriverFromUSBDeviceInterface(device, numInt);
-				}
-				catch ( const GLogiKExcept & e ) {
-					libusb_free_config_descriptor( configDescriptor ); /* free */
-					throw;
-				}
-			} /* for ->num_altsetting */
-		} /* for ->bNumInterfaces */
-
-		libusb_free_config_descriptor( configDescriptor ); /* free */
-	} /* for .bNumConfigurations */
+	for(const int numInt : layout.interfaces) {
+		this->detachKernelDriverFromUSBDeviceInterface(device, numInt);
+	}
 
 	/* trying to set configuration */
 	GKLog2(trace, device.getID(), " setting device active configuration")
@@ -347,19 +508,63 @@ void libusb::setUSBDeviceActiveConfiguration(USBDevice & device)
 	this->attachUSBDeviceInterfacesToKernelDrivers(device);
 }
 
-void libusb::findUSBDeviceInterface(USBDevice & device)
+/*
+ * Descriptors are only walked on the first opening of a given
+ * device model (idVendor, idProduct, bcdDevice). Following openings,
+ * for instance on resume or restart, reuse the cached layout.
+ * Returns true if the layout was found in cache.
+ */
+const bool libusb::getUSBDeviceLayout(
+	USBDevice & device,
+	USBDeviceLayoutKey_type & key,
+	USBDeviceLayout & layout)
 {
 	GK_LOG_FUNC
 
-	int ret = 0;
-
-	GKLog2(trace, device.getID(), " searching for the expected USB device interface")
-
 	libusb_device_descriptor deviceDescriptor;
-	ret = libusb_get_device_descriptor(device._pUSBDevice, &deviceDescriptor);
+	int ret = libusb_get_device_descriptor(device._pUSBDevice, &deviceDescriptor);
 	if( this->USBError(ret) )
 		throw GLogiKExcept("libusb get_device_descriptor failure");
 
+	key = std::make_tuple(
+		deviceDescriptor.idVendor,
+		deviceDescriptor.idProduct,
+		deviceDescriptor.bcdDevice
+	);
+
+	{
+		std::lock_guard<std::mutex> lock(libusb::_layoutsMutex);
+
+		auto it = _layouts.find(key);
+		if( it != _layouts.end() ) {
+			layout = (*it).second;
+			GKLog2(trace, device.getID(), " using cached USB descriptors layout")
+			return true;
+		}
+	}
+
+	this->discoverUSBDeviceLayout(device, deviceDescriptor, layout);
+
+	{
+		std::lock_guard<std::mutex> lock(libusb::_layoutsMutex);
+		_layouts[key] = layout;
+	}
+
+	return false;
+}
+
+void libusb::discoverUSBDeviceLayout(
+	USBDevice & device,
+	const libusb_device_descriptor & deviceDescriptor,
+	USBDeviceLayout & layout)
+{
+	GK_LOG_FUNC
+
+	int ret = 0;
+	bool found = false;
+
+	GKLog2(trace, device.getID(), " searching for the expected USB device interface")
+
 #if DEBUGGING_ON
 	if(GKLogging::GKDebug) {
 		LOG(trace)	<< device.getID() << " number of device configuration(s) : "
@@ -421,13 +626,27 @@ void libusb::findUSBDeviceInterface(USBDevice & device)
 		}
 #endif
 
-		if ( configDescriptor->bConfigurationValue != device.getBConfigurationValue() ) {
-			libusb_free_config_descriptor( configDescriptor ); /* free */
-			continue; /* skip non expected configuration */
-		}
+		const bool expectedConfiguration =
+			( configDescriptor->bConfigurationValue == device.getBConfigurationValue() );
 
 		for (unsigned int j = 0; j < toUInt(configDescriptor->bNumInterfaces); j++) {
 			const libusb_interface *iface = &(configDescriptor->interface[j]);
+
+			for (unsigned int k = 0; k < toUInt(iface->num_altsetting); k++) {
+				const libusb_interface_descriptor * asDescriptor = &(iface->altsetting[k]);
+
+				/* kernel drivers must be detached from all the interfaces
+				 * before setting the active configuration */
+				const int numInt = toInt(asDescriptor->bInterfaceNumber);
+				if( std::find(layout.interfaces.begin(), layout.interfaces.end(), numInt)
+						== layout.interfaces.end() ) {
+					layout.interfaces.push_back(numInt);
+				}
+			}
+
+			if( ! expectedConfiguration )
+				continue; /* skip non expected configuration */
+
 #if DEBUGGING_ON
 			if(GKLogging::GKDebug) {
 				LOG(trace)	<< device.getID() << " interface " << j
@@ -494,49 +713,6 @@ void libusb::findUSBDeviceInterface(USBDevice & device)
 				/* specs found */
 				GKLog2(trace, device.getID(), " found the expected interface, keep going on this road")
 
-				int numInt = toInt(asDescriptor->bInterfaceNumber);
-				try {
-					this->detachKernelDriverFromUSBDeviceInterface(device, numInt);
-				}
-				catch ( const GLogiKExcept & e ) {
-					libusb_free_config_descriptor( configDescriptor ); /* free */
-					throw;
-				}
-
-				/* claiming interface */
-				GKLog3(trace, device.getID(), " claiming interface : ", numInt)
-
-				ret = libusb_claim_interface(device._pUSBDeviceHandle, numInt);	/* claiming */
-				if( this->USBError(ret) ) {
-					libusb_free_config_descriptor( configDescriptor ); /* free */
-					throw GLogiKExcept("failed to claim interface");
-				}
-				device._toRelease.push_back(numInt);	/* claimed */
-
-				{
-					/* once that the interface is claimed, check that the right configuration is set */
-					GKLog2(trace, device.getID(), " checking current active configuration")
-
-					int bConfigurationValue = -1;
-					ret = libusb_get_configuration(device._pUSBDeviceHandle, &bConfigurationValue);
-					if ( this->USBError(ret) ) {
-						libusb_free_config_descriptor( configDescriptor ); /* free */
-						throw GLogiKExcept("libusb get_configuration error");
-					}
-
-					GKLog3(trace, device.getID(), " current active configuration value : ", bConfigurationValue)
-
-					if ( bConfigurationValue != toInt( device.getBConfigurationValue() ) ) {
-						libusb_free_config_descriptor( configDescriptor ); /* free */
-
-						std::ostringstream buffer(std::ios_base::app);
-						buffer << "wrong configuration value : " << bConfigurationValue;
-						GKSysLogError(buffer.str());
-
-						throw GLogiKExcept(buffer.str());
-					}
-				}
-
 				for (unsigned int l = 0; l < toUInt(asDescriptor->bNumEndpoints); l++) {
 					const libusb_endpoint_descriptor * ep = &(asDescriptor->endpoint[l]);
 
@@ -549,7 +725,7 @@ void libusb::findUSBDeviceInterface(USBDevice & device)
 						if( (addr & LIBUSB_ENDPOINT_DIR_MASK) == LIBUSB_ENDPOINT_IN ) {
 							/* In: device-to-host */
 
-							if(device._keysEndpoint != 0) {
+							if(layout.keysEndpoint != 0) {
 								GKSysLogWarning("[Keys] endpoint already found !");
 							}
 							else {
@@ -559,13 +735,13 @@ void libusb::findUSBDeviceInterface(USBDevice & device)
 												<< " MaxPacketSize " << toUInt(ep->wMaxPacketSize);
 								}
 #endif
-								device._keysEndpoint = addr & 0xff;
+								layout.keysEndpoint = addr & 0xff;
 							}
 						}
 						else if( (addr & LIBUSB_ENDPOINT_DIR_MASK) == LIBUSB_ENDPOINT_OUT ) {
 							/* Out: host-to-device */
 
-							if(device._LCDEndpoint != 0) {
+							if(layout.LCDEndpoint != 0) {
 								GKSysLogWarning("[LCD] endpoint already found !");
 							}
 							else {
@@ -575,7 +751,7 @@ void libusb::findUSBDeviceInterface(USBDevice & device)
 												<< " MaxPacketSize " << toUInt(ep->wMaxPacketSize);
 								}
 #endif
-								device._LCDEndpoint = addr & 0xff;
+								layout.LCDEndpoint = addr & 0xff;
 							}
 						}
 
@@ -605,34 +781,85 @@ void libusb::findUSBDeviceInterface(USBDevice & device)
 					}
 				}
 
-				if(device._keysEndpoint == 0) {
+				if(layout.keysEndpoint == 0) {
 					libusb_free_config_descriptor( configDescriptor ); /* free */
 					const std::string err("[Keys] endpoint not found");
 					GKSysLogError(err);
 					throw GLogiKExcept(err);
 				}
 
-				if(device._LCDEndpoint == 0) {
+				if(layout.LCDEndpoint == 0) {
 					libusb_free_config_descriptor( configDescriptor ); /* free */
 					const std::string err("[LCD] endpoint not found");
 					GKSysLogError(err);
 					throw GLogiKExcept(err);
 				}
 
-#if DEBUGGING_ON
-				if(GKLogging::GKDebug) {
-					LOG(info)	<< device.getID() << " all done ! "
-								<< device.getFullName()
-								<< " interface " << numInt
-								<< " opened and ready for I/O transfers";
-				}
-#endif
-
+				found = true;
 			} /* for ->num_altsetting */
 		} /* for ->bNumInterfaces */
 
 		libusb_free_config_descriptor( configDescriptor ); /* free */
 	} /* for .bNumConfigurations */
+
+	if( ! found ) {
+		const std::string err("expected interface not found");
+		GKSysLogError(err);
+		throw GLogiKExcept(err);
+	}
+}
+
+void libusb::claimUSBDeviceInterface(
+	USBDevice & device,
+	const USBDeviceLayout & layout)
+{
+	GK_LOG_FUNC
+
+	const int numInt = toInt( device.getBInterfaceNumber() );
+
+	this->detachKernelDriverFromUSBDeviceInterface(device, numInt);
+
+	/* claiming interface */
+	GKLog3(trace, device.getID(), " claiming interface : ", numInt)
+
+	int ret = libusb_claim_interface(device._pUSBDeviceHandle, numInt);	/* claiming */
+	if( this->USBError(ret) ) {
+		throw GLogiKExcept("failed to claim interface");
+	}
+	device._toRelease.push_back(numInt);	/* claimed */
+
+	{
+		/* once that the interface is claimed, check that the right configuration is set */
+		GKLog2(trace, device.getID(), " checking current active configuration")
+
+		int bConfigurationValue = -1;
+		ret = libusb_get_configuration(device._pUSBDeviceHandle, &bConfigurationValue);
+		if ( this->USBError(ret) ) {
+			throw GLogiKExcept("libusb get_configuration error");
+		}
+
+		GKLog3(trace, device.getID(), " current active configuration value : ", bConfigurationValue)
+
+		if ( bConfigurationValue != toInt( device.getBConfigurationValue() ) ) {
+			std::ostringstream buffer(std::ios_base::app);
+			buffer << "wrong configuration value : " << bConfigurationValue;
+			GKSysLogError(buffer.str());
+
+			throw GLogiKExcept(buffer.str());
+		}
+	}
+
+	device._keysEndpoint = layout.keysEndpoint;
+	device._LCDEndpoint = layout.LCDEndpoint;
+
+#if DEBUGGING_ON
+	if(GKLogging::GKDebug) {
+		LOG(info)	<< device.getID() << " all done ! "
+					<< device.getFullName()
+					<< " interface " << numInt
+					<< " opened and ready for I/O transfers";
+	}
+#endif
 }
 
 void libusb::attachUSBDeviceInterfacesToKernelDrivers(USBDevice & device) noexcept
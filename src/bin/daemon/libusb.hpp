@@ -24,6 +24,11 @@
 
 #include <cstdint>
 
+#include <tuple>
+#include <vector>
+#include <map>
+#include <mutex>
+
 #include <libusb-1.0/libusb.h>
 
 #include "usbinit.hpp"
@@ -32,6 +37,19 @@
 namespace GLogiK
 {
 
+/* idVendor, idProduct, bcdDevice */
+typedef std::tuple<uint16_t, uint16_t, uint16_t> USBDeviceLayoutKey_type;
+
+/* descriptors walk results, same for all devices sharing the same key */
+struct USBDeviceLayout
+{
+	/* interfaces numbers, all configurations */
+	std::vector<int> interfaces;
+
+	uint8_t keysEndpoint = 0;
+	uint8_t LCDEndpoint = 0;
+};
+
 class libusb
 	:	private USBInit
 {
@@ -62,9 +80,45 @@ class libusb
 			unsigned int timeout
 		);
 
+		void cancelUSBDeviceTransfers(USBDevice & device) noexcept;
+		const bool checkUSBDevice(USBDevice & device) noexcept;
+
 	private:
-		void setUSBDeviceActiveConfiguration(USBDevice & device);
-		void findUSBDeviceInterface(USBDevice & device);
+		static void LIBUSB_CALL transferCallback(struct libusb_transfer * pTransfer);
+
+		int performUSBDeviceInterruptTransfer(
+			USBDevice & device,
+			libusb_transfer* & pTransfer,
+			unsigned char endpoint,
+			unsigned char * data,
+			int length,
+			int * transferred,
+			unsigned int timeout,
+			const bool cancellable
+		);
+
+		static std::mutex _layoutsMutex;
+		static std::map<USBDeviceLayoutKey_type, USBDeviceLayout> _layouts;
+
+		const bool getUSBDeviceLayout(
+			USBDevice & device,
+			USBDeviceLayoutKey_type & key,
+			USBDeviceLayout & layout
+		);
+		void discoverUSBDeviceLayout(
+			USBDevice & device,
+			const libusb_device_descriptor & deviceDescriptor,
+			USBDeviceLayout & layout
+		);
+
+		void setUSBDeviceActiveConfiguration(
+			USBDevice & device,
+			const USBDeviceLayout & layout
+		);
+		void claimUSBDeviceInterface(
+			USBDevice & device,
+			const USBDeviceLayout & layout
+		);
 		void releaseUSBDeviceInterfaces(USBDevice & device) noexcept;
 
 		void detachKernelDriverFromUSBDeviceInterface(USBDevice & device, int numInt);
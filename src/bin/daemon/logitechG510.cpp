@@ -22,7 +22,6 @@
 #include <stdexcept>
 #include <new>
 #include <algorithm>
-#include <mutex>
 
 #include "lib/shared/glogik.hpp"
 #include "lib/utils/utils.hpp"
@@ -34,64 +33,6 @@ namespace GLogiK
 
 using namespace NSGKUtils;
 
-const std::vector<RKey> G510Base::keys5BytesMap = {
-//	{ Keys::GK_KEY_,				3,	1 << 2 },
-	{ Keys::GK_KEY_LIGHT,			3,	1 << 3 },
-	{ Keys::GK_KEY_MR,				3,	1 << 7 },
-
-	{ Keys::GK_KEY_MUTE_HEADSET,	4,	1 << 5 },
-	{ Keys::GK_KEY_MUTE_MICRO,		4,	1 << 6 },
-//	{ Keys::GK_KEY_,				4,	1 << 7 },
-};
-
-const std::vector<RKey> G510Base::MKeys5BytesMap = {
-	{ Keys::GK_KEY_M1,	3,	1 << 4 },
-	{ Keys::GK_KEY_M2,	3,	1 << 5 },
-	{ Keys::GK_KEY_M3,	3,	1 << 6 },
-};
-
-const std::vector<RKey> G510Base::GKeys5BytesMap = {
-	{ Keys::GK_KEY_G1,	1,	1 << 0 },
-	{ Keys::GK_KEY_G2,	1,	1 << 1 },
-	{ Keys::GK_KEY_G3,	1,	1 << 2 },
-	{ Keys::GK_KEY_G4,	1,	1 << 3 },
-	{ Keys::GK_KEY_G5,	1,	1 << 4 },
-	{ Keys::GK_KEY_G6,	1,	1 << 5 },
-	{ Keys::GK_KEY_G7,	1,	1 << 6 },
-	{ Keys::GK_KEY_G8,	1,	1 << 7 },
-
-	{ Keys::GK_KEY_G9,	2,	1 << 0 },
-	{ Keys::GK_KEY_G10,	2,	1 << 1 },
-	{ Keys::GK_KEY_G11,	2,	1 << 2 },
-	{ Keys::GK_KEY_G12,	2,	1 << 3 },
-	{ Keys::GK_KEY_G13,	2,	1 << 4 },
-	{ Keys::GK_KEY_G14,	2,	1 << 5 },
-	{ Keys::GK_KEY_G15,	2,	1 << 6 },
-	{ Keys::GK_KEY_G16,	2,	1 << 7 },
-
-	{ Keys::GK_KEY_G17,	3,	1 << 0 },
-	{ Keys::GK_KEY_G18,	3,	1 << 1 },
-};
-
-const std::vector<RKey> G510Base::LCDKeys5BytesMap = {
-	{ Keys::GK_KEY_L1,	4,	1 << 0 },
-	{ Keys::GK_KEY_L2,	4,	1 << 1 },
-	{ Keys::GK_KEY_L3,	4,	1 << 2 },
-	{ Keys::GK_KEY_L4,	4,	1 << 3 },
-	{ Keys::GK_KEY_L5,	4,	1 << 4 },
-};
-
-const std::vector<RKey> G510Base::mediaKeys2BytesMap = {
-	{ Keys::GK_KEY_AUDIO_NEXT,			1,	1 << 0 },
-	{ Keys::GK_KEY_AUDIO_PREV,			1,	1 << 1 },
-	{ Keys::GK_KEY_AUDIO_STOP,			1,	1 << 2 },
-	{ Keys::GK_KEY_AUDIO_PLAY,			1,	1 << 3 },
-	{ Keys::GK_KEY_AUDIO_MUTE,			1,	1 << 4 },
-	{ Keys::GK_KEY_AUDIO_RAISE_VOLUME,	1,	1 << 5 },
-	{ Keys::GK_KEY_AUDIO_LOWER_VOLUME,	1,	1 << 6 },
-//	{ Keys::GK_KEY_,					1,	1 << 7 },
-};
-
 const std::vector<MKeyLed> G510Base::ledsMask = {
 	{ Leds::GK_LED_M1, 1 << 7 },
 	{ Leds::GK_LED_M2, 1 << 6 },
@@ -161,9 +102,9 @@ const MKeysIDArray_type G510Base::getMKeysIDArray(void) const
 	MKeysIDArray_type ret;
 
 	try {
-		ret.reserve(G510Base::MKeys5BytesMap.size());
+		ret.reserve(G510Keys::MKeys5BytesMap.size());
 
-		for(const auto & key : G510Base::MKeys5BytesMap) {
+		for(const auto & key : G510Keys::MKeys5BytesMap) {
 			try {
 				ret.push_back(getMKeyID(key.key));
 			}
@@ -187,9 +128,9 @@ const GKeysIDArray_type G510Base::getGKeysIDArray(void) const
 	GKeysIDArray_type ret;
 
 	try {
-		ret.reserve(G510Base::GKeys5BytesMap.size());
+		ret.reserve(G510Keys::GKeys5BytesMap.size());
 
-		for(const auto & key : G510Base::GKeys5BytesMap)
+		for(const auto & key : G510Keys::GKeys5BytesMap)
 		{
 			try {
 				ret.push_back(getGKeyID(key.key));
@@ -212,39 +153,37 @@ const GKeysIDArray_type G510Base::getGKeysIDArray(void) const
 /* return true if any G-Key (G1-G18) is pressed  */
 const bool G510Base::checkGKey(USBDevice & device)
 {
-	for( const auto & key : G510Base::GKeys5BytesMap ) {
-		if( device._pressedRKeysMask & toEnumType(key.key) ) {
-			device._GKeyID = getGKeyID(key.key);
-			return true;
-		}
-	}
-	return false;
+	const uint64_t GKeys = device._pressedRKeysMask & G510Keys::GKeysMask;
+	if(GKeys == 0)
+		return false;
+
+	device._GKeyID = getGKeyID( getFirstRKey(GKeys) );
+	return true;
 }
 
 /* return true if any media key is pressed */
 const bool G510Base::checkMediaKey(USBDevice & device)
 {
-	for( const auto & key : G510Base::mediaKeys2BytesMap ) {
-		if( device._pressedRKeysMask & toEnumType(key.key) ) {
-			device._mediaKey = getKeyName(key.key);
-			return true;
-		}
-	}
-	return false;
+	const uint64_t mediaKeys = device._pressedRKeysMask & G510Keys::mediaKeysMask;
+	if(mediaKeys == 0)
+		return false;
+
+	device._mediaKey = toEnumType( getFirstRKey(mediaKeys) );
+	return true;
 }
 
 /* return true if any LCD key is pressed */
 const bool G510Base::checkLCDKey(USBDevice & device)
 {
-	for( const auto & key : G510Base::LCDKeys5BytesMap ) {
-		if( device._pressedRKeysMask & toEnumType(key.key) ) {
-			const std::string Key(getKeyName(key.key));
-			std::lock_guard<std::mutex> lock(device._LCDMutex);
-			device._LCDKey = Key;
-			return true;
-		}
+	const uint64_t LCDKeys = device._pressedRKeysMask & G510Keys::LCDKeysMask;
+	if(LCDKeys == 0)
+		return false;
+
+	device._LCDKey = toEnumType( getFirstRKey(LCDKeys) );
+	if( ! device.pushLCDKey(device._LCDKey) ) {
+		GKSysLogWarning(device.getID(), " LCD keys queue full, key dropped");
 	}
-	return false;
+	return true;
 }
 
 /*
@@ -257,10 +196,7 @@ void G510Base::processKeyEvent2Bytes(USBDevice & device)
 	GK_LOG_FUNC
 
 	if (device._pressedKeys[0] == 0x02) {
-		for( const auto & key : G510Base::mediaKeys2BytesMap ) {
-			if( device._pressedKeys[key.index] & key.mask )
-				device._pressedRKeysMask |= toEnumType(key.key);
-		}
+		device._pressedRKeysMask |= G510Keys::keys2BytesTables[1][device._pressedKeys[1]];
 	}
 	else if (device._pressedKeys[0] == 0x04) {
 #if DEBUGGING_ON
@@ -308,28 +244,12 @@ void G510Base::processKeyEvent5Bytes(USBDevice & device)
 		return;
 	}
 
-	for(const auto & key : G510Base::keys5BytesMap) {
-		if( device._pressedKeys[key.index] & key.mask )
-			device._pressedRKeysMask |= toEnumType(key.key);
-	}
-
-	/* M Keys */
-	for(const auto & key : G510Base::MKeys5BytesMap) {
-		if( device._pressedKeys[key.index] & key.mask )
-			device._pressedRKeysMask |= toEnumType(key.key);
-	}
-
-	/* G Keys */
-	for(const auto & key : G510Base::GKeys5BytesMap) {
-		if( device._pressedKeys[key.index] & key.mask )
-			device._pressedRKeysMask |= toEnumType(key.key);
-	}
-
-	/* LCD Keys */
-	for(const auto & key : G510Base::LCDKeys5BytesMap) {
-		if( device._pressedKeys[key.index] & key.mask )
-			device._pressedRKeysMask |= toEnumType(key.key);
-	}
+	/* standard, M, G and LCD keys */
+	device._pressedRKeysMask |=
+		G510Keys::keys5BytesTables[1][device._pressedKeys[1]] |
+		G510Keys::keys5BytesTables[2][device._pressedKeys[2]] |
+		G510Keys::keys5BytesTables[3][device._pressedKeys[3]] |
+		G510Keys::keys5BytesTables[4][device._pressedKeys[4]];
 }
 
 void G510Base::processKeyEvent8Bytes(USBDevice & device)
@@ -24,16 +24,20 @@
 
 #include <cstdint>
 
+#include <array>
 #include <vector>
 #include <string>
 
 #include <config.h>
 
 #include "keyboardDriver.hpp"
+#include "logitechG510Keys.hpp"
 
 #include "USBDeviceID.hpp"
 #include "USBDevice.hpp"
 
+#include "lib/utils/utils.hpp"
+
 #include "include/enums.hpp"
 #include "include/base.hpp"
 
@@ -45,22 +49,12 @@ namespace GLogiK
 #define	   VENDOR_LOGITECH "Logitech"
 #define	VENDOR_ID_LOGITECH "046d"
 
-/* RKey - Recognized Keys */
-struct RKey
-{
-	const Keys key;
-	const uint16_t index;
-	const unsigned char mask;
-};
-
 struct MKeyLed
 {
 	const Leds led;
 	const unsigned char mask;
 };
 
-
-
 class G510Base
 {
 	public:
@@ -95,11 +89,6 @@ class G510Base
 		virtual void setDeviceMxKeysLeds(USBDevice & device);
 
 	private:
-		static const std::vector<RKey>    keys5BytesMap;
-		static const std::vector<RKey>   MKeys5BytesMap;
-		static const std::vector<RKey>   GKeys5BytesMap;
-		static const std::vector<RKey> LCDKeys5BytesMap;
-		static const std::vector<RKey> mediaKeys2BytesMap;
 		static const std::vector<USBDeviceID> knownDevices;
 
 		void processKeyEvent2Bytes(USBDevice & device);
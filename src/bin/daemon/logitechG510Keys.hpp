@@ -0,0 +1,129 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_BIN_DAEMON_LOGITECH_G510_KEYS_HPP_
+#define SRC_BIN_DAEMON_LOGITECH_G510_KEYS_HPP_
+
+#include <cstdint>
+
+#include <array>
+
+#include "RKeys.hpp"
+
+#include "include/enums.hpp"
+
+namespace GLogiK
+{
+
+/* G510 interrupt reports recognized keys, and their decoding tables */
+struct G510Keys
+{
+	static constexpr std::array<RKey, 4> keys5BytesMap = {{
+//		{ Keys::GK_KEY_,				3,	1 << 2 },
+		{ Keys::GK_KEY_LIGHT,			3,	1 << 3 },
+		{ Keys::GK_KEY_MR,				3,	1 << 7 },
+
+		{ Keys::GK_KEY_MUTE_HEADSET,	4,	1 << 5 },
+		{ Keys::GK_KEY_MUTE_MICRO,		4,	1 << 6 },
+//		{ Keys::GK_KEY_,				4,	1 << 7 },
+	}};
+
+	static constexpr std::array<RKey, 3> MKeys5BytesMap = {{
+		{ Keys::GK_KEY_M1,	3,	1 << 4 },
+		{ Keys::GK_KEY_M2,	3,	1 << 5 },
+		{ Keys::GK_KEY_M3,	3,	1 << 6 },
+	}};
+
+	static constexpr std::array<RKey, 18> GKeys5BytesMap = {{
+		{ Keys::GK_KEY_G1,	1,	1 << 0 },
+		{ Keys::GK_KEY_G2,	1,	1 << 1 },
+		{ Keys::GK_KEY_G3,	1,	1 << 2 },
+		{ Keys::GK_KEY_G4,	1,	1 << 3 },
+		{ Keys::GK_KEY_G5,	1,	1 << 4 },
+		{ Keys::GK_KEY_G6,	1,	1 << 5 },
+		{ Keys::GK_KEY_G7,	1,	1 << 6 },
+		{ Keys::GK_KEY_G8,	1,	1 << 7 },
+
+		{ Keys::GK_KEY_G9,	2,	1 << 0 },
+		{ Keys::GK_KEY_G10,	2,	1 << 1 },
+		{ Keys::GK_KEY_G11,	2,	1 << 2 },
+		{ Keys::GK_KEY_G12,	2,	1 << 3 },
+		{ Keys::GK_KEY_G13,	2,	1 << 4 },
+		{ Keys::GK_KEY_G14,	2,	1 << 5 },
+		{ Keys::GK_KEY_G15,	2,	1 << 6 },
+		{ Keys::GK_KEY_G16,	2,	1 << 7 },
+
+		{ Keys::GK_KEY_G17,	3,	1 << 0 },
+		{ Keys::GK_KEY_G18,	3,	1 << 1 },
+	}};
+
+	static constexpr std::array<RKey, 5> LCDKeys5BytesMap = {{
+		{ Keys::GK_KEY_L1,	4,	1 << 0 },
+		{ Keys::GK_KEY_L2,	4,	1 << 1 },
+		{ Keys::GK_KEY_L3,	4,	1 << 2 },
+		{ Keys::GK_KEY_L4,	4,	1 << 3 },
+		{ Keys::GK_KEY_L5,	4,	1 << 4 },
+	}};
+
+	static constexpr std::array<RKey, 7> mediaKeys2BytesMap = {{
+		{ Keys::GK_KEY_AUDIO_NEXT,			1,	1 << 0 },
+		{ Keys::GK_KEY_AUDIO_PREV,			1,	1 << 1 },
+		{ Keys::GK_KEY_AUDIO_STOP,			1,	1 << 2 },
+		{ Keys::GK_KEY_AUDIO_PLAY,			1,	1 << 3 },
+		{ Keys::GK_KEY_AUDIO_MUTE,			1,	1 << 4 },
+		{ Keys::GK_KEY_AUDIO_RAISE_VOLUME,	1,	1 << 5 },
+		{ Keys::GK_KEY_AUDIO_LOWER_VOLUME,	1,	1 << 6 },
+//		{ Keys::GK_KEY_,					1,	1 << 7 },
+	}};
+
+	static constexpr uint64_t GKeysMask = getRKeysMask(GKeys5BytesMap);
+	static constexpr uint64_t LCDKeysMask = getRKeysMask(LCDKeys5BytesMap);
+	static constexpr uint64_t mediaKeysMask = getRKeysMask(mediaKeys2BytesMap);
+
+	/* one lookup table per report byte, first byte is the report ID */
+	static constexpr std::array<RKeysByteTable, 5> build5BytesTables(void)
+	{
+		std::array<RKeysByteTable, 5> tables{};
+		fillRKeysByteTables(tables, G510Keys::keys5BytesMap);
+		fillRKeysByteTables(tables, G510Keys::MKeys5BytesMap);
+		fillRKeysByteTables(tables, G510Keys::GKeys5BytesMap);
+		fillRKeysByteTables(tables, G510Keys::LCDKeys5BytesMap);
+		return tables;
+	}
+
+	static constexpr std::array<RKeysByteTable, 2> build2BytesTables(void)
+	{
+		std::array<RKeysByteTable, 2> tables{};
+		fillRKeysByteTables(tables, G510Keys::mediaKeys2BytesMap);
+		return tables;
+	}
+
+	static const std::array<RKeysByteTable, 5> keys5BytesTables;
+	static const std::array<RKeysByteTable, 2> keys2BytesTables;
+};
+
+/* generated at compile time */
+inline constexpr std::array<RKeysByteTable, 5> G510Keys::keys5BytesTables = G510Keys::build5BytesTables();
+inline constexpr std::array<RKeysByteTable, 2> G510Keys::keys2BytesTables = G510Keys::build2BytesTables();
+
+} // namespace GLogiK
+
+#endif
@@ -0,0 +1,422 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <thread>
+#include <new>
+
+#include "lib/utils/utils.hpp"
+
+#include "simusb.hpp"
+
+#include "USBAPIenums.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+SimUSBScript simusb::_script;
+
+/*
+ * script format, one statement per line, '#' starts a comment :
+ *   rate <n>          keys reports per second (default 100)
+ *   devices <n>       number of simulated devices (default 1)
+ *   capture <file>    LCD frames and feature reports capture file prefix
+ *   keys <bytes>      hexadecimal interrupt report, either space or comma
+ *                     separated, as printed by DEBUG_KEYS traces
+ *   wait <ms>         delay the next report
+ *   timeout           next keys transfer times out
+ *   error             next keys transfer fails
+ *   lcd-error         next LCD transfer fails
+ *   loop              restart from the beginning once the end is reached
+ * at the end of a non-looping script, keys transfers always time out
+ */
+void simusb::loadScript(const std::string & scriptFile)
+{
+	GK_LOG_FUNC
+
+	GKLog2(trace, "loading USB simulator script : ", scriptFile)
+
+	std::ifstream ifs(scriptFile);
+	if( ! ifs.is_open() )
+		throw GLogiKExcept("failed to open USB simulator script");
+
+	SimUSBScript script;
+	bool transferStep = false;
+
+	std::string line;
+	unsigned int lineNumber = 0;
+	while( std::getline(ifs, line) ) {
+		lineNumber++;
+
+		const std::size_t comment = line.find('#');
+		if(comment != std::string::npos)
+			line.erase(comment);
+
+		std::istringstream iss(line);
+		std::string statement;
+		if( ! (iss >> statement) )
+			continue;
+
+		std::string value;
+		std::getline(iss >> std::ws, value);
+
+		try {
+			if(statement == "rate") {
+				script.rate = toUInt(value);
+				if(script.rate == 0)
+					throw GLogiKExcept("null rate");
+			}
+			else if(statement == "devices") {
+				script.devices = toUInt(value);
+				if(script.devices > 127)
+					throw GLogiKExcept("too many devices");
+			}
+			else if(statement == "capture") {
+				script.captureFile = value;
+			}
+			else if(statement == "loop") {
+				script.loop = true;
+			}
+			else {
+				SimUSBStep step;
+				if(statement == "keys") {
+					step.type = SimUSBStepType::STEP_KEYS;
+					simusb::parseReport(value, step.report);
+					transferStep = true;
+				}
+				else if(statement == "wait") {
+					step.type = SimUSBStepType::STEP_WAIT;
+					step.ms = toUInt(value);
+				}
+				else if(statement == "timeout") {
+					step.type = SimUSBStepType::STEP_TIMEOUT;
+					transferStep = true;
+				}
+				else if(statement == "error") {
+					step.type = SimUSBStepType::STEP_ERROR;
+					transferStep = true;
+				}
+				else if(statement == "lcd-error") {
+					step.type = SimUSBStepType::STEP_LCD_ERROR;
+				}
+				else {
+					throw GLogiKExcept("unknown statement");
+				}
+				script.steps.push_back( std::move(step) );
+			}
+		}
+		catch ( const GLogiKExcept & e ) {
+			std::ostringstream buffer(std::ios_base::app);
+			buffer << scriptFile << ":" << lineNumber << " : " << e.what();
+			throw GLogiKExcept(buffer.str());
+		}
+	}
+
+	/* a looping script must give back control to the keys thread */
+	if( script.loop and ( ! transferStep ) )
+		throw GLogiKExcept("looping USB simulator script without any transfer");
+
+	_script = std::move(script);
+
+	GKLog4(trace, "USB simulator script steps : ", _script.steps.size(),
+		"devices : ", _script.devices)
+}
+
+const unsigned int simusb::getSimulatedDevicesCount(void)
+{
+	return _script.devices;
+}
+
+void simusb::parseReport(
+	const std::string & line,
+	std::vector<unsigned char> & report)
+{
+	std::string bytes(line);
+	std::replace(bytes.begin(), bytes.end(), ',', ' ');
+
+	std::istringstream iss(bytes);
+	std::string byte;
+	while( iss >> byte ) {
+		const unsigned long value = toUL(byte, 16);
+		if(value > 0xFF)
+			throw GLogiKExcept("report byte out of range");
+		report.push_back( static_cast<unsigned char>(value) );
+	}
+
+	if( report.empty() or (report.size() > KEYS_BUFFER_LENGTH) )
+		throw GLogiKExcept("wrong report length");
+}
+
+/*
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ *
+ *  === protected === protected === protected === protected ===
+ *
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+
+simusb::simusb()
+{
+	GK_LOG_FUNC
+
+	GKLog(trace, "initializing USB simulator")
+}
+
+simusb::~simusb()
+{
+	GK_LOG_FUNC
+
+	GKLog(trace, "closing USB simulator")
+}
+
+void simusb::openUSBDevice(USBDevice & device)
+{
+	GK_LOG_FUNC
+
+	if( (device.getBus() != simusb::simulatedBus) or
+		(device.getNum() == 0) or (device.getNum() > _script.devices) )
+		throw GLogiKExcept("not a simulated device");
+
+	try {
+		device._pSimDevice = new SimUSBDevice();
+	}
+	catch (const std::bad_alloc& e) { /* handle new() failure */
+		throw GLogiKBadAlloc("simulated device allocation failure");
+	}
+
+	SimUSBDevice & sim = *(device._pSimDevice);
+	sim.nextReport = std::chrono::steady_clock::now();
+
+	if( ! _script.captureFile.empty() ) {
+		const std::string file(
+			_script.captureFile + "." + std::to_string(toUInt(device.getNum()))
+		);
+
+		sim.capture.open(file, std::ios_base::out | std::ios_base::trunc);
+		if( ! sim.capture.is_open() ) {
+			GKSysLogWarning("failed to open USB simulator capture file : ", file);
+		}
+	}
+
+	GKLog2(trace, device.getID(), " opened simulated USB device")
+}
+
+void simusb::closeUSBDevice(USBDevice & device) noexcept
+{
+	GK_LOG_FUNC
+
+	if(device._pSimDevice != nullptr) {
+		const SimUSBDevice & sim = *(device._pSimDevice);
+
+		std::ostringstream buffer(std::ios_base::app);
+		buffer	<< device.getID() << " simulated device stats - keys reports: " << sim.keysReports
+				<< " timeouts: " << sim.keysTimeouts
+				<< " errors: " << sim.keysErrors
+				<< " - LCD frames: " << sim.LCDFrames
+				<< " errors: " << sim.LCDErrors
+				<< " - feature reports: " << sim.featureReports;
+		GKSysLogInfo(buffer.str());
+
+		delete device._pSimDevice;
+		device._pSimDevice = nullptr;
+
+		GKLog2(trace, device.getID(), " closed simulated USB device")
+	}
+}
+
+void simusb::sendUSBDeviceFeatureReport(
+	USBDevice & device,
+	const unsigned char * data,
+	uint16_t wLength)
+{
+	GK_LOG_FUNC
+
+	if( ! device.getUSBRequestsStatus() ) {
+		GKSysLogWarning("skip device feature report sending, would probably fail");
+		return;
+	}
+
+	SimUSBDevice & sim = *(device._pSimDevice);
+	sim.featureReports++;
+	this->captureData(sim, "feature", data, wLength);
+
+	GKLog3(trace, device.getID(), " sent simulated feature report: ", wLength)
+}
+
+int simusb::performUSBDeviceKeysInterruptTransfer(
+	USBDevice & device,
+	unsigned int timeout)
+{
+	GK_LOG_FUNC
+
+	if( ! device.getUSBRequestsStatus() ) {
+		GKSysLogWarning("skip device keys transfer, would probably fail");
+		return 0;
+	}
+
+	device._lastKeysInterruptTransferLength = 0;
+
+	SimUSBDevice & sim = *(device._pSimDevice);
+	const auto & steps = _script.steps;
+
+	const auto now = std::chrono::steady_clock::now();
+	const auto deadline = now + std::chrono::milliseconds(timeout);
+
+	/* after a long pause (stopped threads), do not burst the backlog */
+	if( sim.nextReport + std::chrono::seconds(1) < now )
+		sim.nextReport = now;
+
+	auto timedOut = [&sim, &deadline] () -> int {
+		std::this_thread::sleep_until(deadline);
+		sim.keysTimeouts++;
+		return toEnumType(USBAPIKeysTransferStatus::TRANSFER_TIMEOUT);
+	};
+
+	while( true ) {
+		if( sim.position >= steps.size() ) {
+			if( ! _script.loop )
+				return timedOut();
+			sim.position = 0;
+		}
+
+		const SimUSBStep & step = steps[sim.position];
+
+		switch(step.type) {
+			case SimUSBStepType::STEP_WAIT:
+				sim.nextReport += std::chrono::milliseconds(step.ms);
+				sim.position++;
+				break;
+			case SimUSBStepType::STEP_LCD_ERROR:
+				sim.pendingLCDErrors++;
+				sim.position++;
+				break;
+			case SimUSBStepType::STEP_TIMEOUT:
+				sim.position++;
+				return timedOut();
+			case SimUSBStepType::STEP_ERROR:
+				sim.position++;
+				sim.keysErrors++;
+				GKSysLogError("simulated keys transfer error");
+				return toEnumType(USBAPIKeysTransferStatus::TRANSFER_ERROR);
+			case SimUSBStepType::STEP_KEYS:
+				{
+					if(sim.nextReport > deadline)
+						return timedOut();
+
+					std::this_thread::sleep_until(sim.nextReport);
+					sim.nextReport += std::chrono::microseconds(1000000 / _script.rate);
+
+					const int length = std::min(
+						static_cast<int>(step.report.size()),
+						toInt(device.getKeysInterruptBufferMaxLength())
+					);
+					std::copy_n(step.report.data(), length, device._pressedKeys);
+
+					sim.position++;
+					sim.keysReports++;
+
+					/* actual number of bytes read */
+					device._lastKeysInterruptTransferLength = length;
+					return 0;
+				}
+		}
+	}
+}
+
+int simusb::performUSBDeviceLCDScreenInterruptTransfer(
+	USBDevice & device,
+	const unsigned char * buffer,
+	int bufferLength,
+	unsigned int timeout)
+{
+	GK_LOG_FUNC
+
+	if( ! device.getUSBRequestsStatus() ) {
+		GKSysLogWarning("skip device LCD transfer, would probably fail");
+		return 0;
+	}
+
+	SimUSBDevice & sim = *(device._pSimDevice);
+
+	/* only decremented by the LCD thread */
+	if(sim.pendingLCDErrors > 0) {
+		sim.pendingLCDErrors--;
+		sim.LCDErrors++;
+		GKSysLogError("simulated LCD transfer error");
+		return toEnumType(USBAPIKeysTransferStatus::TRANSFER_ERROR);
+	}
+
+	sim.LCDFrames++;
+	this->captureData(sim, "lcd", buffer, bufferLength);
+
+	/* actual number of bytes written */
+	device._lastLCDInterruptTransferLength = bufferLength;
+	return 0;
+}
+
+/* simulated transfers never block longer than their timeout */
+void simusb::cancelUSBDeviceTransfers(USBDevice & device) noexcept
+{
+}
+
+const bool simusb::checkUSBDevice(USBDevice & device) noexcept
+{
+	return (device._pSimDevice != nullptr);
+}
+
+/*
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ *
+ * === private === private === private === private === private ===
+ *
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ * --- --- --- --- --- --- --- --- --- --- --- --- --- --- --- ---
+ */
+
+/* one line per transfer : type length hexadecimal bytes */
+void simusb::captureData(
+	SimUSBDevice & sim,
+	const char * type,
+	const unsigned char * data,
+	const int length)
+{
+	std::lock_guard<std::mutex> lock(sim.captureMutex);
+
+	if( ! sim.capture.is_open() )
+		return;
+
+	sim.capture << type << " " << std::dec << length << std::hex << std::setfill('0');
+	for(int i = 0; i < length; i++) {
+		sim.capture << " " << std::setw(2) << toUInt(data[i]);
+	}
+	sim.capture << "\n";
+}
+
+} // namespace GLogiK
@@ -0,0 +1,146 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SRC_BIN_DAEMON_SIMUSB_HPP_
+#define SRC_BIN_DAEMON_SIMUSB_HPP_
+
+#include <cstdint>
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+#include "USBDevice.hpp"
+
+namespace GLogiK
+{
+
+enum class SimUSBStepType : uint8_t
+{
+	STEP_KEYS = 0,		/* interrupt report delivered on the keys endpoint */
+	STEP_WAIT,			/* delay before the next report */
+	STEP_TIMEOUT,		/* one keys transfer times out */
+	STEP_ERROR,			/* one keys transfer fails */
+	STEP_LCD_ERROR,		/* next LCD transfer fails */
+};
+
+struct SimUSBStep
+{
+	SimUSBStepType type;
+	std::vector<unsigned char> report;
+	unsigned int ms = 0;
+};
+
+/* parsed simulator script, shared by all simulated devices */
+struct SimUSBScript
+{
+	std::vector<SimUSBStep> steps;
+	std::string captureFile;
+	unsigned int rate = 100;	/* keys reports per second */
+	unsigned int devices = 1;	/* number of simulated devices */
+	bool loop = false;
+};
+
+/* per-device simulator state, see USBDevice::_pSimDevice */
+struct SimUSBDevice
+{
+	std::size_t position = 0;
+	std::chrono::steady_clock::time_point nextReport;
+
+	std::atomic<unsigned int> pendingLCDErrors{0};
+
+	std::mutex captureMutex;
+	std::ofstream capture;
+
+	/* statistics, logged on close */
+	unsigned int keysReports = 0;
+	unsigned int keysTimeouts = 0;
+	unsigned int keysErrors = 0;
+	std::atomic<unsigned int> LCDFrames{0};
+	std::atomic<unsigned int> LCDErrors{0};
+	std::atomic<unsigned int> featureReports{0};
+};
+
+/*
+ * in-process USB device backend, replays a script of interrupt
+ * reports instead of talking to an actual device
+ */
+class simusb
+{
+	public:
+		/* bus number used by simulated devices */
+		static constexpr uint8_t simulatedBus = 255;
+
+		static void loadScript(const std::string & scriptFile);
+		static const unsigned int getSimulatedDevicesCount(void);
+
+	protected:
+		simusb(void);
+		~simusb(void);
+
+		void openUSBDevice(USBDevice & device);
+		void closeUSBDevice(USBDevice & device) noexcept;
+
+		void sendUSBDeviceFeatureReport(
+			USBDevice & device,
+			const unsigned char * data,
+			uint16_t wLength
+		);
+
+		int performUSBDeviceKeysInterruptTransfer(
+			USBDevice & device,
+			unsigned int timeout
+		);
+
+		int performUSBDeviceLCDScreenInterruptTransfer(
+			USBDevice & device,
+			const unsigned char * buffer,
+			int bufferLength,
+			unsigned int timeout
+		);
+
+		void cancelUSBDeviceTransfers(USBDevice & device) noexcept;
+		const bool checkUSBDevice(USBDevice & device) noexcept;
+
+	private:
+		/* loaded once from the command line, read-only afterwards */
+		static SimUSBScript _script;
+
+		static void parseReport(
+			const std::string & line,
+			std::vector<unsigned char> & report
+		);
+
+		void captureData(
+			SimUSBDevice & sim,
+			const char * type,
+			const unsigned char * data,
+			const int length
+		);
+};
+
+} // namespace GLogiK
+
+#endif
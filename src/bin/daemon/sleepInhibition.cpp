@@ -162,16 +162,19 @@ void SleepInhibition::handleSleepEvent(const bool mode)
 	GK_LOG_FUNC
 
 	if(mode) {
-		GKLog(trace, "going to sleep, stopping devices")
-		_pDevicesManager->stopInitializedDevices();
+		GKLog(trace, "going to sleep, suspending devices")
+		_pDevicesManager->suspendInitializedDevices();
 		this->releaseDelayLock();
 	}
 	else {
 		GKLog(trace, "resuming from sleep, starting devices")
 		this->inhibitSleepState();
-		/* don't start devices too early after resuming */
-		std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-		_pDevicesManager->startSleepingDevices();
+		/* devices still opened are resumed right away */
+		if( ! _pDevicesManager->resumeSuspendedDevices() ) {
+			/* don't re-open devices too early after resuming */
+			std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+			_pDevicesManager->startSleepingDevices();
+		}
 	}
 }
 
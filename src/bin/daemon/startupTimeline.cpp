@@ -0,0 +1,211 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <new>
+#include <sstream>
+#include <fstream>
+
+#include "lib/utils/utils.hpp"
+
+#include "startupTimeline.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+/* initialized before main() */
+const StartupTimeline::clock_type::time_point StartupTimeline::_origin = StartupTimeline::clock_type::now();
+std::mutex StartupTimeline::_eventsMutex;
+std::vector<StartupTimeline::PhaseEvent> StartupTimeline::_events;
+int64_t StartupTimeline::_devicesReady = -1;
+bool StartupTimeline::_finished = false;
+
+StartupTimeline::Phase::Phase(const std::string & name)
+	:	_name(name),
+		_start(StartupTimeline::clock_type::now()),
+		_stopped(false)
+{
+}
+
+StartupTimeline::Phase::~Phase(void)
+{
+	this->stop();
+}
+
+void StartupTimeline::Phase::stop(void) noexcept
+{
+	if( _stopped )
+		return;
+
+	_stopped = true;
+	StartupTimeline::addEvent(_name, _start, StartupTimeline::clock_type::now());
+}
+
+/* first call only, devices opened on startup */
+void StartupTimeline::markDevicesReady(void) noexcept
+{
+	std::lock_guard<std::mutex> lock(_eventsMutex);
+	if( _finished or (_devicesReady >= 0) )
+		return;
+
+	_devicesReady = StartupTimeline::getMicroseconds( clock_type::now() );
+}
+
+void StartupTimeline::finish(const std::string & traceFile)
+{
+	GK_LOG_FUNC
+
+	const int64_t mainLoop = StartupTimeline::getMicroseconds( clock_type::now() );
+
+	{
+		std::lock_guard<std::mutex> lock(_eventsMutex);
+		if( _finished )
+			return;
+		_finished = true;
+	}
+
+	/* no more writers from here */
+#if DEBUGGING_ON
+	if(GKLogging::GKDebug) {
+		for(const auto & event : _events) {
+			LOG(info)	<< "startup phase : " << event.name
+						<< " - start (ms) : " << (event.start / 1000)
+						<< " - duration (ms) : " << (event.duration / 1000)
+						<< " - thread : " << event.tid;
+		}
+	}
+#endif
+
+	{
+		std::ostringstream buffer(std::ios_base::app);
+		buffer << "startup : ";
+		if( _devicesReady >= 0 )
+			buffer << "devices ready in " << (_devicesReady / 1000) << " ms, ";
+		buffer << "main loop reached in " << (mainLoop / 1000) << " ms";
+		GKSysLogInfo(buffer.str());
+	}
+
+	if( ! traceFile.empty() ) {
+		std::lock_guard<std::mutex> lock(_eventsMutex);
+		_events.push_back( {"main loop", mainLoop, 0, static_cast<pid_t>(syscall(SYS_gettid))} );
+		if( _devicesReady >= 0 )
+			_events.push_back( {"devices ready", _devicesReady, 0, static_cast<pid_t>(syscall(SYS_gettid))} );
+
+		StartupTimeline::writeTraceEvents(traceFile);
+	}
+
+	_events.clear();
+	_events.shrink_to_fit();
+}
+
+const int64_t StartupTimeline::getMicroseconds(const clock_type::time_point & t)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(t - _origin).count();
+}
+
+void StartupTimeline::addEvent(
+	const std::string & name,
+	const clock_type::time_point & start,
+	const clock_type::time_point & end) noexcept
+{
+	const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+	try {
+		std::lock_guard<std::mutex> lock(_eventsMutex);
+		if( _finished )
+			return;
+
+		_events.push_back(
+			{
+				name,
+				StartupTimeline::getMicroseconds(start),
+				std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+				tid
+			}
+		);
+	}
+	catch (const std::bad_alloc& e) { /* handle new() failure */
+		GKSysLogError("startup phase allocation failure");
+	}
+}
+
+/*
+ * Trace Event Format, can be loaded into chrome://tracing or ui.perfetto.dev
+ * https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ */
+void StartupTimeline::writeTraceEvents(const std::string & traceFile)
+{
+	GK_LOG_FUNC
+
+	auto escape = [] (const std::string & s) -> const std::string {
+		std::string ret;
+		for(const char c : s) {
+			if( (c == '"') or (c == '\\') )
+				ret += '\\';
+			ret += c;
+		}
+		return ret;
+	};
+
+	const pid_t pid = getpid();
+
+	std::ofstream traceStream;
+	traceStream.exceptions( std::ofstream::failbit|std::ofstream::badbit );
+	try {
+		traceStream.open(traceFile, std::ofstream::trunc);
+
+		traceStream << "{\"traceEvents\":[";
+		bool first = true;
+		for(const auto & event : _events) {
+			if( ! first )
+				traceStream << ",";
+			first = false;
+
+			traceStream	<< "\n{\"name\":\"" << escape(event.name) << "\"";
+			if( event.duration > 0 ) {
+				traceStream << ",\"ph\":\"X\",\"dur\":" << event.duration;
+			}
+			else {
+				traceStream << ",\"ph\":\"i\",\"s\":\"g\"";
+			}
+			traceStream	<< ",\"ts\":" << event.start
+						<< ",\"pid\":" << pid
+						<< ",\"tid\":" << event.tid << "}";
+		}
+		traceStream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+		traceStream.close();
+
+		std::ostringstream buffer(std::ios_base::app);
+		buffer << "startup trace written to : " << traceFile;
+		GKSysLogInfo(buffer.str());
+	}
+	catch (const std::ofstream::failure & e) {
+		GKSysLogWarning("failed to write startup trace : ", traceFile);
+	}
+}
+
+} // namespace GLogiK
@@ -0,0 +1,103 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SRC_BIN_DAEMON_STARTUP_TIMELINE_HPP_
+#define SRC_BIN_DAEMON_STARTUP_TIMELINE_HPP_
+
+#include <sys/types.h>
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+
+namespace GLogiK
+{
+
+/*
+ * Records the daemon startup phases, from the process start up
+ * to the main loop. Phases may be recorded from any thread, once
+ * ::finish() is called, following phases are ignored.
+ */
+class StartupTimeline
+{
+	public:
+		typedef std::chrono::steady_clock clock_type;
+
+		/* records a phase from construction to destruction */
+		class Phase
+		{
+			public:
+				Phase(const std::string & name);
+				~Phase(void);
+
+				Phase(const Phase &) = delete;
+				Phase & operator=(const Phase &) = delete;
+
+				/* ends the phase before destruction */
+				void stop(void) noexcept;
+
+			private:
+				const std::string _name;
+				const clock_type::time_point _start;
+				bool _stopped;
+		};
+
+		static void markDevicesReady(void) noexcept;
+
+		/* logs a summary, and writes a trace-event JSON file if traceFile is not empty */
+		static void finish(const std::string & traceFile);
+
+	protected:
+
+	private:
+		StartupTimeline(void) = delete;
+		~StartupTimeline(void) = delete;
+
+		struct PhaseEvent
+		{
+			std::string name;
+			int64_t start;		/* microseconds since process start */
+			int64_t duration;	/* microseconds, 0 for instant events */
+			pid_t tid;
+		};
+
+		static const clock_type::time_point _origin;
+		static std::mutex _eventsMutex;
+		static std::vector<PhaseEvent> _events;
+		static int64_t _devicesReady;
+		static bool _finished;
+
+		static const int64_t getMicroseconds(const clock_type::time_point & t);
+		static void addEvent(
+			const std::string & name,
+			const clock_type::time_point & start,
+			const clock_type::time_point & end
+		) noexcept;
+		static void writeTraceEvents(const std::string & traceFile);
+};
+
+} // namespace GLogiK
+
+#endif
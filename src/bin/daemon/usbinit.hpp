@@ -56,6 +56,7 @@ class USBInit
 	protected:
 		int USBError(int errorCode) noexcept;
 		void seekUSBDevice(USBDevice & device);
+		libusb_context * getUSBContext(void) const { return USBInit::pContext; }
 
 	private:
 		static libusb_context * pContext;
@@ -301,14 +301,16 @@ void MainWindow::build(void)
 		std::bind(&MainWindow::resetInterface, this)
 	);
 
-	_pDBus->NSGKDBus::Callback<SIGs2v>::receiveSignal(
+	_pDBus->NSGKDBus::Callback<SIGsy2v>::receiveSignal(
 		_sessionBus,
 		GLOGIK_DESKTOP_SERVICE_DBUS_BUS_CONNECTION_NAME,
 		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_OBJECT_PATH,
 		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_INTERFACE,
 		"DeviceConfigurationSaved",
-		{ {"s", "device_id", "in", "device ID"}, },
-		std::bind(&MainWindow::configurationFileUpdated, this, std::placeholders::_1)
+		{	{"s", "device_id", "in", "device ID"},
+			{"y", "changes", "in", "configuration changes mask"}, },
+		std::bind(&MainWindow::configurationFileUpdated, this,
+			std::placeholders::_1, std::placeholders::_2)
 	);
 
 	QObject::connect(qApp, &QCoreApplication::aboutToQuit, this, &MainWindow::aboutToQuit);
@@ -368,10 +370,12 @@ void MainWindow::aboutToQuit(void)
 	LOG(info) << "GKcQt MainWindow process exiting, bye !";
 }
 
-void MainWindow::configurationFileUpdated(const std::string & devID)
+void MainWindow::configurationFileUpdated(const std::string & devID, const uint8_t changes)
 {
 	GK_LOG_FUNC
 
+	GKLog4(trace, devID, " configuration file updated", "changes mask : ", toUInt(changes))
+
 	if( _ignoreNextSignal ) {
 		GKLog(trace, "DeviceConfigurationSaved signal ignored")
 
@@ -122,7 +122,7 @@ class MainWindow
 		void saveConfigurationFile(const TabApplyButton tab);
 		void saveConfigurationFileAndUpdateInterface(const TabApplyButton tab);
 
-		void configurationFileUpdated(const std::string & devID);
+		void configurationFileUpdated(const std::string & devID, const uint8_t changes);
 };
 
 } // namespace GLogiK
@@ -45,7 +45,7 @@ DBusHandler::DBusHandler(
 	:	_clientID("undefined"),
 		_daemonVersion("unknown"),
 		_CURRENT_SESSION_DBUS_OBJECT_PATH(""),
-		_sessionState(""),
+		_sessionState(SessionState::SESSION_UNKNOWN),
 		_pDepsMap(dependencies),
 		_sessionFramework(SessionFramework::FW_UNKNOWN),
 		_registerStatus(false)
@@ -97,27 +97,41 @@ void DBusHandler::checkNotifyEvents(NSGKUtils::FileSystem* pGKfs)
 {
 	GK_LOG_FUNC
 
-	DevicesFilesMap_type devicesMap = _devices.getDevicesFilesMap();
+	NotifiedDevices_type devicesID;
 
-	pGKfs->readNotifyEvents( devicesMap );
+	pGKfs->readNotifyEvents( devicesID );
 
-	for( const auto & device : devicesMap ) {
-		GKLog4(trace,
-			device.first, " filesystem notification event",
-			"reloading file : ", device.second
-		)
-		_devices.reloadDeviceConfigurationFile(device.first);
+	uint8_t changes = 0;
+	for( const auto & devID : devicesID ) {
+		GKLog2(trace, devID, " filesystem notification event, reloading file")
+		changes |= _devices.reloadDeviceConfigurationFile(devID);
+	}
 
-		/*
-		 * force state update, to load active user's parameters
-		 * for all plugged devices
-		 */
-		if( _sessionState == "active" ) {
-			this->reportChangedState();
-		}
+	/* G-Keys banks are handled by the service only */
+	const uint8_t daemonChanges =
+		toEnumType(ConfigurationChange::GK_CONFIG_BACKLIGHT_COLOR) |
+		toEnumType(ConfigurationChange::GK_CONFIG_LCD_PLUGINS_MASK);
+
+	/*
+	 * force state update, to load active user's parameters
+	 * for all plugged devices
+	 */
+	if( ( changes & daemonChanges ) and ( _sessionState == SessionState::SESSION_ACTIVE ) ) {
+		this->reportChangedState();
 	}
 }
 
+const int DBusHandler::getChildrenSignalDescriptor(void) const
+{
+	return _GKeysEvent.getChildrenSignalDescriptor();
+}
+
+/* reap terminated processes spawned by G-Keys commands */
+void DBusHandler::checkChildrenSignals(void)
+{
+	_GKeysEvent.reapChildren();
+}
+
 /* return false if we want to exit on next main loop run */
 const bool DBusHandler::getExitStatus(void) const
 {
@@ -209,6 +223,10 @@ void DBusHandler::handleSignal(int signum)
 			DBusHandler::WantToExit = true;
 			DBusHandler::sendServiceStartRequest();
 			break;
+		case SIGUSR2:
+			/* exported from the service main loop */
+			GKTrace::requestDump();
+			break;
 		default:
 			LOG(warning) << process::getSignalHandlingDesc(signum, " --> unhandled");
 			break;
@@ -406,15 +424,16 @@ void DBusHandler::setCurrentSessionObjectPath(pid_t pid)
 
 				_sessionFramework = SessionFramework::FW_LOGIND;
 
-				/* update session state when PropertyChanged signal receipted */
-				DBus.NSGKDBus::Callback<SIGv2v>::receiveSignal(
+				/* update session state from PropertiesChanged signal arguments */
+				DBus.NSGKDBus::Callback<SIGspas2v>::receiveSignal(
 					_systemBus,
 					LOGIND_DBUS_BUS_CONNECTION_NAME,
 					_CURRENT_SESSION_DBUS_OBJECT_PATH.c_str(),
 					FREEDESKTOP_DBUS_PROPERTIES_STANDARD_INTERFACE,
 					"PropertiesChanged",
 					{},
-					std::bind(&DBusHandler::updateSessionState, this)
+					std::bind(&DBusHandler::sessionPropertiesChanged, this,
+						std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)
 				);
 
 				LOG(info) << "successfully contacted logind";
@@ -438,26 +457,90 @@ void DBusHandler::setCurrentSessionObjectPath(pid_t pid)
 	throw GLogiKExcept("unable to contact a session manager");
 }
 
+/*
+ * Ask the session tracker for the current session state (blocking call).
+ * Only used on startup, and when the state property is invalidated
+ * instead of being sent with the PropertiesChanged signal.
+ */
 void DBusHandler::updateSessionState(void)
 {
 	GK_LOG_FUNC
 
-	_sessionState = this->getCurrentSessionState();
+	this->setSessionState( this->getCurrentSessionState() );
+}
+
+void DBusHandler::setSessionState(const SessionState newState)
+{
+	GK_LOG_FUNC
+
+	const SessionState oldState = _sessionState.exchange(newState);
+
+	if(oldState == newState) {
+		GKLog2(trace, "session state unchanged : ", toSessionStateString(newState))
+		return;
+	}
 
-	GKLog2(trace, "switching session state to : ", _sessionState)
+	GKLog2(trace, "switching session state to : ", toSessionStateString(newState))
 
 	this->reportChangedState();
 }
 
+/*
+ * logind sends the Active property with its value when the
+ * session state changes, State (when sent) takes precedence.
+ * Other properties changes (IdleHint, LockedHint, ...) are ignored.
+ */
+void DBusHandler::sessionPropertiesChanged(
+	const std::string & interface,
+	const NSGKDBus::GKDBusProperties_type & changedProperties,
+	const std::vector<std::string> & invalidatedProperties)
+{
+	GK_LOG_FUNC
+
+	if(interface != LOGIND_SESSION_DBUS_INTERFACE) {
+		GKLog2(trace, "ignoring properties changes on interface : ", interface)
+		return;
+	}
+
+	auto it = changedProperties.find("State");
+	if(it != changedProperties.end()) {
+		this->setSessionState( toSessionState(it->second) );
+		return;
+	}
+
+	it = changedProperties.find("Active");
+	if(it != changedProperties.end()) {
+		if(it->second == "true") {
+			this->setSessionState(SessionState::SESSION_ACTIVE);
+		}
+		/* an inactive closing session is still closing */
+		else if(_sessionState != SessionState::SESSION_CLOSING) {
+			this->setSessionState(SessionState::SESSION_ONLINE);
+		}
+		return;
+	}
+
+	for(const auto & property : invalidatedProperties) {
+		if( (property == "State") or (property == "Active") ) {
+			GKLog2(trace, "invalidated session property : ", property)
+			try {
+				this->updateSessionState();
+			}
+			catch (const GLogiKExcept & e) {
+				LOG(error) << e.what();
+			}
+			return;
+		}
+	}
+
+	GKLog(trace, "session state not affected by properties changes")
+}
+
 /*
  * Ask to session tracker the current session state, and returns it.
  * If the state fails to be updated for whatever reason, throws.
- * Possible returns values are :
- *  - active
- *  - online
- *  - closing
  */
-const std::string DBusHandler::getCurrentSessionState(void)
+const SessionState DBusHandler::getCurrentSessionState(void)
 {
 	GK_LOG_FUNC
 
@@ -480,7 +563,7 @@ const std::string DBusHandler::getCurrentSessionState(void)
 
 				try {
 					DBus.waitForRemoteMethodCallReply();
-					return DBus.getNextStringArgument();
+					return toSessionState( DBus.getNextStringArgument() );
 				}
 				catch (const GLogiKExcept & e) {
 					LogRemoteCallGetReplyFailure
@@ -519,7 +602,7 @@ void DBusHandler::reportChangedState(void)
 			remoteMethod.c_str()
 		);
 		DBus.appendStringToRemoteMethodCall(_clientID);
-		DBus.appendStringToRemoteMethodCall(_sessionState);
+		DBus.appendStringToRemoteMethodCall( toSessionStateString(_sessionState) );
 		DBus.sendRemoteMethodCall();
 
 		try {
@@ -529,7 +612,7 @@ void DBusHandler::reportChangedState(void)
 				LOG(error) << "failed to report changed state : false";
 			}
 			else {
-				GKLog2(trace, "successfully reported changed state : ", _sessionState)
+				GKLog2(trace, "successfully reported changed state : ", toSessionStateString(_sessionState))
 			}
 			return;
 		}
@@ -896,6 +979,15 @@ void DBusHandler::initializeGKDBusMethods(void)
 			{"as", "array_of_strings", "out", "array of informations strings"} },
 		std::bind(&DBusHandler::getInformations, this, r_ed) );
 
+	DBus.NSGKDBus::Callback<SIGs2as>::exposeMethod(
+		_sessionBus,
+		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_OBJECT_PATH,
+		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_INTERFACE,
+		"GetLaunchedProcessesStats",
+		{	{"s", r_ed, "in", r_ed},
+			{"as", "array_of_strings", "out", "in-flight, spawned, failed, exited, non-zero exits, last exit status"} },
+		std::bind(&DBusHandler::getLaunchedProcessesStats, this, r_ed) );
+
 	DBus.NSGKDBus::Callback<SIGss2aP>::exposeMethod(
 		_sessionBus,
 		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_OBJECT_PATH,
@@ -914,6 +1006,25 @@ void DBusHandler::initializeGKDBusMethods(void)
 		{	{"s", r_ed, "in", r_ed},
 			{"a(yta(sss))", "dependencies_map", "out", "array of executable dependencies"} },
 		std::bind(&DBusHandler::getExecutablesDependenciesMap, this, r_ed) );
+
+	DBus.NSGKDBus::Callback<SIGs2as>::exposeMethod(
+		_sessionBus,
+		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_OBJECT_PATH,
+		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_INTERFACE,
+		"GetServiceMetrics",
+		{	{"s", r_ed, "in", r_ed},
+			{"as", "array_of_strings", "out", "array of name=value macros playback and D-Bus round-trips metrics"} },
+		std::bind(&DBusHandler::getServiceMetrics, this, r_ed) );
+
+	DBus.NSGKDBus::Callback<SIGss2as>::exposeMethod(
+		_sessionBus,
+		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_OBJECT_PATH,
+		GLOGIK_DESKTOP_SERVICE_SESSION_DBUS_INTERFACE,
+		"GetDeviceMetrics",
+		{	{"s", "device_id", "in", "device ID"},
+			{"s", r_ed, "in", r_ed},
+			{"as", "array_of_strings", "out", "array of name=value device metrics coming from daemon"} },
+		std::bind(&DBusHandler::getDeviceMetrics, this, std::placeholders::_1, r_ed) );
 }
 
 void DBusHandler::daemonIsStopping(void)
@@ -942,7 +1053,8 @@ void DBusHandler::daemonIsStarting(void)
 		try {
 			this->registerWithDaemon();
 			if( _registerStatus ) {
-				this->updateSessionState();
+				/* session state is kept up to date by logind signals */
+				this->reportChangedState();
 				_devices.setClientID(_clientID);
 				this->initializeDevices();
 			}
@@ -1014,7 +1126,7 @@ void DBusHandler::devicesStarted(const std::vector<std::string> & devicesID)
 	 * force state update, to load active user's parameters
 	 * for all hotplugged devices
 	 */
-	if( _sessionState == "active" ) {
+	if( _sessionState == SessionState::SESSION_ACTIVE ) {
 		this->reportChangedState();
 	}
 }
@@ -1137,6 +1249,8 @@ void DBusHandler::deviceMBankSwitch(
 {
 	GK_LOG_FUNC
 
+	LatencyProbe::mark(LatencyFlow::LATENCY_MKEY, LatencyStage::STAGE_SIGNAL_RECEIVED);
+
 	GKLog4(trace,
 		devID, " received signal : DeviceMBankSwitch",
 		"bankID : ", bankID
@@ -1147,7 +1261,7 @@ void DBusHandler::deviceMBankSwitch(
 		return;
 	}
 
-	if( _sessionState != "active" ) {
+	if( _sessionState != SessionState::SESSION_ACTIVE ) {
 		GKLog(trace, "currently not active, skipping")
 		return;
 	}
@@ -1155,6 +1269,7 @@ void DBusHandler::deviceMBankSwitch(
 	LOG(info) << "received DeviceMBankSwitch signal : " << bankID;
 
 	try {
+		LatencyProbe::mark(LatencyFlow::LATENCY_MKEY, LatencyStage::STAGE_EVENT_RUN);
 		_devices.setDeviceCurrentBankID(devID, bankID);
 	}
 	catch (const GLogiKExcept & e) {
@@ -1169,6 +1284,8 @@ void DBusHandler::deviceMacroRecorded(
 {
 	GK_LOG_FUNC
 
+	LatencyProbe::mark(LatencyFlow::LATENCY_MACRO_RECORD, LatencyStage::STAGE_SIGNAL_RECEIVED);
+
 	GKLog4(trace,
 		devID, " received signal : DeviceMacroRecorded",
 		"key : ", getGKeyName(keyID)
@@ -1179,7 +1296,7 @@ void DBusHandler::deviceMacroRecorded(
 		return;
 	}
 
-	if( _sessionState != "active" ) {
+	if( _sessionState != SessionState::SESSION_ACTIVE ) {
 		GKLog(trace, "currently not active, skipping")
 		return;
 	}
@@ -1188,9 +1305,11 @@ void DBusHandler::deviceMacroRecorded(
 		MKeysID bankID;
 		banksMap_type & banksMap = _devices.getDeviceBanks(devID, bankID);
 
+		LatencyProbe::mark(LatencyFlow::LATENCY_MACRO_RECORD, LatencyStage::STAGE_EVENT_RUN);
 		_GKeysEvent.setMacro(banksMap, macro, bankID, keyID);
 
 		_devices.saveDeviceConfigurationFile(devID);
+		LatencyProbe::mark(LatencyFlow::LATENCY_MACRO_RECORD, LatencyStage::STAGE_OUTPUT);
 	}
 	catch (const GLogiKExcept & e) {
 		LOG(error) << devID << " macro record failure - " << keyID;
@@ -1211,7 +1330,7 @@ void DBusHandler::deviceMacroCleared(const std::string & devID, const GKeysID ke
 		return;
 	}
 
-	if( _sessionState != "active" ) {
+	if( _sessionState != SessionState::SESSION_ACTIVE ) {
 		GKLog(trace, "currently not active, skipping")
 		return;
 	}
@@ -1235,6 +1354,8 @@ void DBusHandler::deviceMediaEvent(
 {
 	GK_LOG_FUNC
 
+	LatencyProbe::mark(LatencyFlow::LATENCY_MEDIA, LatencyStage::STAGE_SIGNAL_RECEIVED);
+
 	GKLog4(trace,
 		devID, " received signal : DeviceMediaEvent",
 		"event : ", mediaKeyEvent
@@ -1245,11 +1366,12 @@ void DBusHandler::deviceMediaEvent(
 		return;
 	}
 
-	if( _sessionState != "active" ) {
+	if( _sessionState != SessionState::SESSION_ACTIVE ) {
 		GKLog(trace, "currently not active, skipping")
 		return;
 	}
 
+	LatencyProbe::mark(LatencyFlow::LATENCY_MEDIA, LatencyStage::STAGE_EVENT_RUN);
 	_devices.doDeviceFakeKeyEvent(devID, mediaKeyEvent);
 }
 
@@ -1257,6 +1379,8 @@ void DBusHandler::deviceGKeyEvent(const std::string & devID, const GKeysID keyID
 {
 	GK_LOG_FUNC
 
+	LatencyProbe::mark(LatencyFlow::LATENCY_GKEY, LatencyStage::STAGE_SIGNAL_RECEIVED);
+
 	GKLog4(trace,
 		devID, " received signal : DeviceGKeyEvent",
 		"key : ", getGKeyName(keyID)
@@ -1267,20 +1391,21 @@ void DBusHandler::deviceGKeyEvent(const std::string & devID, const GKeysID keyID
 		return;
 	}
 
-	if( _sessionState != "active" ) {
+	if( _sessionState != SessionState::SESSION_ACTIVE ) {
 		GKLog(trace, "currently not active, skipping")
 		return;
 	}
 
-	try {
-		MKeysID bankID;
-		banksMap_type & banksMap = _devices.getDeviceBanks(devID, bankID);
-
-		_GKeysEvent.runEvent(banksMap, bankID, keyID);
-	}
-	catch (const GLogiKExcept & e) {
+	const GKeysActionTable* pActions = _devices.getDeviceActionTable(devID);
+	if(pActions == nullptr) {
 		LOG(error) << devID << " run event failure - " << keyID;
+		return;
 	}
+
+	GKLog2(trace, "MBank: ", pActions->getCurrentBankID())
+
+	LatencyProbe::mark(LatencyFlow::LATENCY_GKEY, LatencyStage::STAGE_EVENT_RUN);
+	_GKeysEvent.runEvent( pActions->getAction(keyID) );
 };
 
 const std::vector<std::string> DBusHandler::getDevicesList(const std::string & reserved) {
@@ -1299,6 +1424,11 @@ const std::vector<std::string> DBusHandler::getInformations(const std::string &
 	return ret;
 }
 
+const std::vector<std::string> DBusHandler::getLaunchedProcessesStats(const std::string & reserved)
+{
+	return _GKeysEvent.getLaunchedProcessesStats();
+}
+
 const LCDPPArray_type & DBusHandler::getDeviceLCDPluginsProperties(
 	const std::string & devID,
 	const std::string & reserved)
@@ -1306,6 +1436,21 @@ const LCDPPArray_type & DBusHandler::getDeviceLCDPluginsProperties(
 	return _devices.getDeviceLCDPluginsProperties(devID);
 }
 
+const std::vector<std::string> DBusHandler::getServiceMetrics(const std::string & reserved)
+{
+	std::vector<std::string> ret;
+	_GKeysEvent.appendMacrosMetrics(ret);
+	DBus.getRemoteMethodCallsRoundTrips().appendTo(ret, "dbus.round_trip_time");
+	return ret;
+}
+
+const std::vector<std::string> DBusHandler::getDeviceMetrics(
+	const std::string & devID,
+	const std::string & reserved)
+{
+	return _devices.getDeviceMetrics(devID);
+}
+
 const GKDepsMap_type & DBusHandler::getExecutablesDependenciesMap(const std::string & reserved)
 {
 	return (*_pDepsMap);
@@ -22,6 +22,7 @@
 #ifndef SRC_BIN_SERVICE_DBUS_HANDLER_HPP_
 #define SRC_BIN_SERVICE_DBUS_HANDLER_HPP_
 
+#include <atomic>
 #include <vector>
 #include <string>
 
@@ -59,6 +60,8 @@ class DBusHandler
 
 		const bool getExitStatus(void) const;
 		void checkNotifyEvents(NSGKUtils::FileSystem* pGKfs);
+		const int getChildrenSignalDescriptor(void) const;
+		void checkChildrenSignals(void);
 		void cleanDBusRequests(void);
 
 	protected:
@@ -73,7 +76,7 @@ class DBusHandler
 		std::string _clientID;
 		std::string _daemonVersion;
 		std::string _CURRENT_SESSION_DBUS_OBJECT_PATH;	/* current session object path */
-		std::string _sessionState;		/* session state */
+		std::atomic<SessionState> _sessionState;	/* session state */
 
 		const GKDepsMap_type* const _pDepsMap;
 
@@ -84,9 +87,15 @@ class DBusHandler
 		/* -- -- -- */
 
 		void setCurrentSessionObjectPath(pid_t pid);
-		const std::string getCurrentSessionState(void);
+		const SessionState getCurrentSessionState(void);
 
 		void updateSessionState(void);
+		void setSessionState(const SessionState newState);
+		void sessionPropertiesChanged(
+			const std::string & interface,
+			const NSGKDBus::GKDBusProperties_type & changedProperties,
+			const std::vector<std::string> & invalidatedProperties
+		);
 
 		void registerWithDaemon(void);
 		void unregisterWithDaemon(void);
@@ -132,11 +141,17 @@ class DBusHandler
 
 		const std::vector<std::string> getDevicesList(const std::string & reserved);
 		const std::vector<std::string> getInformations(const std::string & reserved);
+		const std::vector<std::string> getLaunchedProcessesStats(const std::string & reserved);
 		const LCDPPArray_type & getDeviceLCDPluginsProperties(
 			const std::string & devID,
 			const std::string & reserved
 		);
 		const GKDepsMap_type & getExecutablesDependenciesMap(const std::string & reserved);
+		const std::vector<std::string> getServiceMetrics(const std::string & reserved);
+		const std::vector<std::string> getDeviceMetrics(
+			const std::string & devID,
+			const std::string & reserved
+		);
 };
 
 } // namespace GLogiK
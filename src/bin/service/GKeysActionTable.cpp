@@ -0,0 +1,161 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <sstream>
+
+#include "lib/utils/utils.hpp"
+
+#include "GKeysActionTable.hpp"
+#include "processLauncher.hpp"
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+const GKeyAction GKeysActionTable::inactiveAction = {};
+
+GKeysActionTable::GKeysActionTable(void)
+	:	_currentBankID(MKeysID::MKEY_M0)
+{
+}
+
+GKeysActionTable::~GKeysActionTable(void)
+{
+}
+
+void GKeysActionTable::build(
+	const banksMap_type & GKeysBanks,
+	const MKeysID bankID)
+{
+	GK_LOG_FUNC
+
+	for(auto & bank : _actions) {
+		for(auto & action : bank) {
+			action = inactiveAction;
+		}
+	}
+
+	for(const auto & bankPair : GKeysBanks) {
+		const std::size_t b = toEnumType(bankPair.first);
+		if(b >= MKeysNum)
+			continue;
+
+		for(const auto & eventPair : bankPair.second) {
+			const std::size_t k = toEnumType(eventPair.first);
+			if( (k >= GKeysNum) or (eventPair.first == GKeyID_INV) )
+				continue;
+
+			const GKeysEvent & event = eventPair.second;
+			GKeyAction & action = _actions[b][k];
+
+			switch(event.getEventType()) {
+				case GKeyEventType::GKEY_MACRO:
+					if( ! event.getMacro().empty() ) {
+						action.type = GKeyEventType::GKEY_MACRO;
+						GKeysActionTable::decodeMacro(event.getMacro(), action.macro);
+					}
+					break;
+				case GKeyEventType::GKEY_RUNCMD:
+					if( ! event.getCommand().empty() ) {
+						action.type = GKeyEventType::GKEY_RUNCMD;
+						GKeysActionTable::parseCommand(event.getCommand(), action);
+					}
+					break;
+				default:
+					break;
+			}
+		}
+	}
+
+	this->setCurrentBankID(bankID);
+}
+
+void GKeysActionTable::setCurrentBankID(const MKeysID bankID)
+{
+	if(toEnumType(bankID) >= MKeysNum) {
+		LOG(warning) << "wrong bankID: " << bankID;
+		return;
+	}
+
+	_currentBankID = bankID;
+}
+
+const MKeysID GKeysActionTable::getCurrentBankID(void) const
+{
+	return _currentBankID;
+}
+
+const GKeyAction & GKeysActionTable::getAction(const GKeysID keyID) const
+{
+	const std::size_t k = toEnumType(keyID);
+	if( (k >= GKeysNum) or (keyID == GKeyID_INV) )
+		return inactiveAction;
+
+	return _actions[toEnumType(_currentBankID)][k];
+}
+
+void GKeysActionTable::decodeMacro(
+	const macro_type & macro,
+	std::vector<MacroChunk> & chunks)
+{
+	input_event syn = {};
+	syn.type = EV_SYN;
+	syn.code = SYN_REPORT;
+	syn.value = 0;
+
+	for(const auto & key : macro) {
+		/* same threshold than VirtualKeyboard::sendKeyEvent() */
+		if( chunks.empty() or (key.interval > 20) ) {
+			chunks.push_back( { static_cast<uint16_t>((key.interval > 20) ? key.interval : 0), {} } );
+		}
+
+		input_event ev = {};
+		ev.type = EV_KEY;
+		ev.code = key.code;
+		ev.value = static_cast<int32_t>(key.event);
+
+		chunks.back().events.push_back(ev);
+		chunks.back().events.push_back(syn);
+	}
+}
+
+void GKeysActionTable::parseCommand(
+	const std::string & command,
+	GKeyAction & action)
+{
+	action.command = command;
+
+	std::istringstream tmpstream(command);
+	std::string tmpstring;
+	std::getline(tmpstream, action.exe, ' ');
+	while(std::getline(tmpstream, tmpstring, ' '))
+	{
+		action.args.push_back(tmpstring);
+	}
+
+	/* warm up PATH resolution cache */
+	if( ProcessLauncher::searchPath(action.exe).empty() ) {
+		LOG(warning) << action.exe << " executable not found in PATH";
+	}
+}
+
+} // namespace GLogiK
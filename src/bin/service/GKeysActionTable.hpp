@@ -0,0 +1,99 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_BIN_SERVICE_GKEYS_ACTION_TABLE_HPP_
+#define SRC_BIN_SERVICE_GKEYS_ACTION_TABLE_HPP_
+
+#include <cstdint>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <linux/input.h>
+
+#include "include/base.hpp"
+#include "include/MBank.hpp"
+
+namespace GLogiK
+{
+
+/* consecutive macro events that can be written in one go,
+ * after sleeping for delay milliseconds */
+struct MacroChunk
+{
+	uint16_t delay;
+	std::vector<input_event> events;
+};
+
+struct GKeyAction
+{
+	GKeyEventType type = GKeyEventType::GKEY_INACTIVE;
+
+	/* GKEY_MACRO - pre-decoded EV_KEY/EV_SYN events */
+	std::vector<MacroChunk> macro;
+
+	/* GKEY_RUNCMD - pre-parsed command */
+	std::string command;
+	std::string exe;
+	std::vector<std::string> args;
+};
+
+class GKeysActionTable
+{
+	public:
+		GKeysActionTable(void);
+		~GKeysActionTable(void);
+
+		void build(
+			const banksMap_type & GKeysBanks,
+			const MKeysID bankID
+		);
+
+		void setCurrentBankID(const MKeysID bankID);
+		const MKeysID getCurrentBankID(void) const;
+
+		const GKeyAction & getAction(const GKeysID keyID) const;
+
+	protected:
+
+	private:
+		static constexpr std::size_t MKeysNum = static_cast<std::size_t>(MKeyID_MAX) + 1;
+		static constexpr std::size_t GKeysNum = static_cast<std::size_t>(GKeyID_MAX) + 1;
+
+		static const GKeyAction inactiveAction;
+
+		std::array<std::array<GKeyAction, GKeysNum>, MKeysNum> _actions;
+		MKeysID _currentBankID;
+
+		static void decodeMacro(
+			const macro_type & macro,
+			std::vector<MacroChunk> & chunks
+		);
+		static void parseCommand(
+			const std::string & command,
+			GKeyAction & action
+		);
+};
+
+} // namespace GLogiK
+
+#endif
@@ -21,25 +21,22 @@
 
 #include <string>
 #include <vector>
-#include <sstream>
+#include <thread>
+#include <chrono>
 #include <stdexcept>
 
 #include "lib/shared/glogik.hpp"
 #include "lib/utils/utils.hpp"
 
-#include <boost/process.hpp>
-#include <boost/process/search_path.hpp>
-
 #include "GKeysEventManager.hpp"
 
-namespace bp = boost::process;
-
 namespace GLogiK
 {
 
 using namespace NSGKUtils;
 
 GKeysEventManager::GKeysEventManager(void)
+	:	_macrosKeyEvents(0)
 {
 }
 
@@ -47,55 +44,36 @@ GKeysEventManager::~GKeysEventManager(void)
 {
 }
 
-void GKeysEventManager::runEvent(
-	const banksMap_type & GKeysBanks,
-	const MKeysID bankID,
-	const GKeysID keyID)
+void GKeysEventManager::runEvent(const GKeyAction & action)
 {
 	GK_LOG_FUNC
 
-	if(keyID == GKeyID_INV) {
-		LOG(error) << "invalid GKeyID";
-		return;
-	}
+	if(action.type == GKeyEventType::GKEY_MACRO) {
+		GKLog(trace, "running macro")
+		const auto start = std::chrono::steady_clock::now();
+		bool first = true;
+		for(const auto & chunk : action.macro) {
+			if( chunk.delay > 0 ) {
+				GKLog3(trace, "sleeping for : ", chunk.delay, "ms")
 
-	try {
-		const mBank_type & bank = GKeysBanks.at(bankID);
-		try {
-			const GKeysEvent & event = bank.at(keyID);
-			GKLog4(trace, "MBank: ", bankID, "GKey: ", getGKeyName(keyID))
-
-			if(event.getEventType() == GKeyEventType::GKEY_INACTIVE) {
-				GKLog(trace, "inactive event")
+				std::this_thread::sleep_for(std::chrono::milliseconds(chunk.delay));
 			}
-			else if(event.getEventType() == GKeyEventType::GKEY_MACRO) {
-				const macro_type & macro = event.getMacro();
-				if( ! macro.empty() ) {
-					GKLog(trace, "running macro")
-					for(const auto & key : macro) {
-						_virtualKeyboard.sendKeyEvent(key);
-					}
-				}
+			_virtualKeyboard.sendKeyEvents(chunk.events);
+			_macrosKeyEvents += chunk.events.size();
 
-			}
-			else if(event.getEventType() == GKeyEventType::GKEY_RUNCMD) {
-				this->spawnProcess(event.getCommand());
-			}
-			else if(event.getEventType() == GKeyEventType::GKEY_INVALID) {
-				LOG(error) << "invalid event type";
-				return;
+			if( first ) {
+				LatencyProbe::mark(LatencyFlow::LATENCY_GKEY, LatencyStage::STAGE_OUTPUT);
+				first = false;
 			}
 		}
-		catch(const std::out_of_range& oor) {
-			LOG(warning) << "wrong GKeyID: " << keyID;
-			throw GLogiKExcept("run event failed");
-		}
+		_macrosPlayback.add(std::chrono::steady_clock::now() - start);
 	}
-	catch (const std::out_of_range& oor) {
-		LOG(warning) << "wrong bankID: " << bankID;
-		throw GLogiKExcept("run event failed");
+	else if(action.type == GKeyEventType::GKEY_RUNCMD) {
+		this->spawnProcess(action);
+	}
+	else {
+		GKLog(trace, "inactive event")
 	}
-
 }
 
 void GKeysEventManager::setMacro(
@@ -196,39 +174,36 @@ void GKeysEventManager::setMacro(
 	}
 }
 
-void GKeysEventManager::spawnProcess(const std::string & command)
+void GKeysEventManager::spawnProcess(const GKeyAction & action)
 {
 	GK_LOG_FUNC
 
-	LOG(info) << "spawning process: " << command;
-
-	std::string exe;
-	std::vector<std::string> args;
-	{
-		std::istringstream tmpstream(command);
-		std::string tmpstring;
-		std::getline(tmpstream, exe, ' ');
-		while(std::getline(tmpstream, tmpstring, ' '))
-		{
-			args.push_back(tmpstring);
-		}
-	}
+	LOG(info) << "spawning process: " << action.command;
 
-	try {
-		auto p = bp::search_path(exe);
-		if( p.empty() ) {
-			LOG(error) << exe << " executable not found in PATH";
-			return;
-		}
+	GKLog4(trace, "spawning: ", action.exe, "with args size: ", action.args.size())
 
-		GKLog4(trace, "spawning: ", exe, "with args size: ", args.size())
+	_launcher.spawn(action.exe, action.args);
+}
 
-		bp::spawn(p, bp::args(args));
-	}
-	catch (const bp::process_error & e) {
-		LOG(error) << "exception catched while trying to spawn process: " << command;
-		LOG(error) << e.what();
-	}
+const int GKeysEventManager::getChildrenSignalDescriptor(void) const
+{
+	return _launcher.getSignalDescriptor();
+}
+
+void GKeysEventManager::reapChildren(void)
+{
+	_launcher.reapChildren();
+}
+
+const std::vector<std::string> GKeysEventManager::getLaunchedProcessesStats(void) const
+{
+	return _launcher.getStats();
+}
+
+void GKeysEventManager::appendMacrosMetrics(std::vector<std::string> & metrics) const
+{
+	_macrosPlayback.appendTo(metrics, "macros.playback_time");
+	metrics.push_back("macros.key_events=" + std::to_string(_macrosKeyEvents));
 }
 
 } // namespace GLogiK
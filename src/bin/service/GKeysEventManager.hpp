@@ -22,9 +22,17 @@
 #ifndef SRC_BIN_SERVICE_GKEYS_EVENT_MANAGER_HPP_
 #define SRC_BIN_SERVICE_GKEYS_EVENT_MANAGER_HPP_
 
+#include <cstdint>
+
+#include <vector>
+#include <string>
+
+#include "lib/utils/utils.hpp"
 #include "lib/shared/GKeysBanksCapability.hpp"
 #include "lib/shared/GKeysMacro.hpp"
 #include "virtualKeyboard.hpp"
+#include "GKeysActionTable.hpp"
+#include "processLauncher.hpp"
 
 #include "include/base.hpp"
 #include "include/MBank.hpp"
@@ -39,11 +47,12 @@ class GKeysEventManager
 		GKeysEventManager(void);
 		~GKeysEventManager(void);
 
-		void runEvent(
-			const banksMap_type & GKeysBanks,
-			const MKeysID bankID,
-			const GKeysID keyID
-		);
+		void runEvent(const GKeyAction & action);
+
+		const int getChildrenSignalDescriptor(void) const;
+		void reapChildren(void);
+		const std::vector<std::string> getLaunchedProcessesStats(void) const;
+		void appendMacrosMetrics(std::vector<std::string> & metrics) const;
 
 		void setMacro(
 			banksMap_type & GKeysBanks,
@@ -62,6 +71,11 @@ class GKeysEventManager
 
 	private:
 		VirtualKeyboard _virtualKeyboard;
+		ProcessLauncher _launcher;
+
+		/* macros playback, from first chunk to last key event sent */
+		NSGKUtils::MetricsHistogram _macrosPlayback;
+		uint64_t _macrosKeyEvents;
 
 		void setMacro(
 			banksMap_type & GKeysBanks,
@@ -70,7 +84,7 @@ class GKeysEventManager
 			const macro_type & macro
 		);
 
-		void spawnProcess(const std::string & command);
+		void spawnProcess(const GKeyAction & action);
 };
 
 } // namespace GLogiK
@@ -46,7 +46,8 @@ using namespace NSGKUtils;
 
 DevicesHandler::DevicesHandler()
 	:	_clientID("undefined"),
-		_pGKfs(nullptr)
+		_pGKfs(nullptr),
+		_pLastActionTable(nullptr)
 {
 	GK_LOG_FUNC
 
@@ -97,18 +98,8 @@ void DevicesHandler::clearDevices(const bool notifications)
 	/* clear all containers */
 	_startedDevices.clear();
 	_stoppedDevices.clear();
-}
-
-const DevicesFilesMap_type DevicesHandler::getDevicesFilesMap(void)
-{
-	DevicesFilesMap_type ret;
-	for(const auto & dev : _startedDevices) {
-		ret.insert( std::pair<std::string, const std::string>(dev.first, dev.second.getConfigFilePath()) );
-	}
-	for(const auto & dev : _stoppedDevices) {
-		ret.insert( std::pair<std::string, const std::string>(dev.first, dev.second.getConfigFilePath()) );
-	}
-	return ret;
+	_actionTables.clear();
+	_pLastActionTable = nullptr;
 }
 
 const std::vector<std::string> DevicesHandler::getDevicesList(void)
@@ -162,7 +153,12 @@ const bool DevicesHandler::checkDeviceCapability(const DeviceProperties & device
 	return (device.getCapabilities() & toEnumType(toCheck));
 }
 
-void DevicesHandler::reloadDeviceConfigurationFile(const std::string & devID)
+/*
+ * Reload the configuration file and compare it with the current one,
+ * only changed settings are sent to the daemon. Returns the mask of
+ * ConfigurationChange bits, 0 when nothing relevant changed.
+ */
+const uint8_t DevicesHandler::reloadDeviceConfigurationFile(const std::string & devID)
 {
 	GK_LOG_FUNC
 
@@ -172,33 +168,48 @@ void DevicesHandler::reloadDeviceConfigurationFile(const std::string & devID)
 		if( it != _ignoredFSNotifications.cend() ) {
 			GKLog2(trace, devID, " ignoring filesystem notification after configuration file save")
 			_ignoredFSNotifications.erase(it);
-			return;
+			return 0;
 		}
 	}
 
-	try {
-		DeviceProperties & device = _startedDevices.at(devID);
+	auto reloadDevice = [this, &devID] (DeviceProperties & device) -> const uint8_t {
+		const DeviceProperties previous(device);
 		this->loadDeviceConfigurationFile(device);
 
-		this->sendDeviceConfigurationToDaemon(devID, device);
+		const uint8_t changes = device.getConfigurationChanges(previous);
+		if(changes == 0) {
+			GKLog2(trace, devID, " configuration file reloaded, nothing changed")
+			return 0;
+		}
+
+		GKLog3(trace, devID, " configuration changes mask : ", toUInt(changes))
+
+		this->sendDeviceConfigurationToDaemon(devID, device, changes);
 
 		/* inform GUI that configuration file was reloaded */
-		this->sendDeviceConfigurationSavedSignal(devID);
+		this->sendDeviceConfigurationSavedSignal(devID, changes);
+
+		return changes;
+	};
+
+	try {
+		DeviceProperties & device = _startedDevices.at(devID);
+		const uint8_t changes = reloadDevice(device);
+		if( changes & toEnumType(ConfigurationChange::GK_CONFIG_GKEYS_BANKS) )
+			this->buildDeviceActionTable(devID, device);
+		return changes;
 	}
 	catch (const std::out_of_range& oor) {
 		try {
 			DeviceProperties & device = _stoppedDevices.at(devID);
-			this->loadDeviceConfigurationFile(device);
-
-			this->sendDeviceConfigurationToDaemon(devID, device);
-
-			/* inform GUI that configuration file was reloaded */
-			this->sendDeviceConfigurationSavedSignal(devID);
+			return reloadDevice(device);
 		}
 		catch (const std::out_of_range& oor) {
 			LOG(warning) << devID << " device not found in containers, giving up";
 		}
 	}
+
+	return 0;
 }
 
 void DevicesHandler::saveDeviceConfigurationFile(const std::string & devID)
@@ -208,6 +219,9 @@ void DevicesHandler::saveDeviceConfigurationFile(const std::string & devID)
 	try {
 		DeviceProperties & device = _startedDevices.at(devID);
 
+		/* banks were modified in place, refresh actions table */
+		this->buildDeviceActionTable(devID, device);
+
 		this->initializeConfigurationDirectory(device);
 		this->saveDeviceConfigurationFile(devID, device);
 	}
@@ -265,7 +279,9 @@ void DevicesHandler::saveDeviceConfigurationFile(
 	}
 }
 
-void DevicesHandler::sendDeviceConfigurationSavedSignal(const std::string & devID)
+void DevicesHandler::sendDeviceConfigurationSavedSignal(
+	const std::string & devID,
+	const uint8_t changes)
 {
 	GK_LOG_FUNC
 
@@ -278,6 +294,7 @@ void DevicesHandler::sendDeviceConfigurationSavedSignal(const std::string & devI
 			"DeviceConfigurationSaved"
 		);
 		DBus.appendStringToBroadcastSignal(devID);
+		DBus.appendUInt8ToBroadcastSignal(changes);
 		DBus.sendBroadcastSignal();
 
 		GKLog2(trace, devID, " sent signal on session bus : DeviceConfigurationSaved")
@@ -299,11 +316,13 @@ void DevicesHandler::loadDeviceConfigurationFile(DeviceProperties & device)
 
 void DevicesHandler::sendDeviceConfigurationToDaemon(
 	const std::string & devID,
-	const DeviceProperties & device)
+	const DeviceProperties & device,
+	const uint8_t changes)
 {
 	GK_LOG_FUNC
 
-	if( this->checkDeviceCapability(device, Caps::GK_BACKLIGHT_COLOR) ) {
+	if( ( changes & toEnumType(ConfigurationChange::GK_CONFIG_BACKLIGHT_COLOR) ) and
+		this->checkDeviceCapability(device, Caps::GK_BACKLIGHT_COLOR) ) {
 		/* set backlight color */
 		const std::string remoteMethod("SetDeviceBacklightColor");
 
@@ -349,7 +368,8 @@ void DevicesHandler::sendDeviceConfigurationToDaemon(
 	//if( this->checkDeviceCapability(device, Caps::GK_MACROS_KEYS) ) {
 	//}
 
-	if( this->checkDeviceCapability(device, Caps::GK_LCD_SCREEN) ) {
+	if( ( changes & toEnumType(ConfigurationChange::GK_CONFIG_LCD_PLUGINS_MASK) ) and
+		this->checkDeviceCapability(device, Caps::GK_LCD_SCREEN) ) {
 		const std::string remoteMethod = "SetDeviceLCDPluginsMask";
 
 		try {
@@ -553,6 +573,9 @@ void DevicesHandler::setDeviceProperties(
 			LOG(error) << devID << " failed to create default configuration file : " << e.what();
 		}
 	}
+
+	if( ! device.getConfigFilePath().empty() )
+		_pGKfs->addNotifyFile(device.getConfigFilePath(), devID);
 }
 
 void DevicesHandler::startDevice(const std::string & devID, const bool notifications)
@@ -571,6 +594,8 @@ void DevicesHandler::startDevice(const std::string & devID, const bool notificat
 			_startedDevices[devID] = device;
 			_stoppedDevices.erase(devID);
 
+			this->buildDeviceActionTable(devID, _startedDevices[devID]);
+
 #if HAVE_DESKTOP_NOTIFICATIONS
 			if(notifications)
 				this->showNotification(devID, "Device started", device);
@@ -583,6 +608,8 @@ void DevicesHandler::startDevice(const std::string & devID, const bool notificat
 			this->setDeviceProperties(devID, device);
 			_startedDevices[devID] = device;
 
+			this->buildDeviceActionTable(devID, device);
+
 #if HAVE_DESKTOP_NOTIFICATIONS
 			if(notifications)
 				this->showNotification(devID, "Device started", device);
@@ -606,6 +633,7 @@ void DevicesHandler::stopDevice(const std::string & devID, const bool notificati
 			LOG(info) << devID << " stopping device";
 			_stoppedDevices[devID] = device;
 			_startedDevices.erase(devID);
+			this->eraseDeviceActionTable(devID);
 
 #if HAVE_DESKTOP_NOTIFICATIONS
 			if(notifications)
@@ -623,6 +651,7 @@ void DevicesHandler::stopDevice(const std::string & devID, const bool notificati
 				LOG(info) << devID << " stopping device";
 				_stoppedDevices[devID] = device;
 				_startedDevices.erase(devID);
+				this->eraseDeviceActionTable(devID);
 
 #if HAVE_DESKTOP_NOTIFICATIONS
 				if(notifications)
@@ -660,6 +689,7 @@ void DevicesHandler::unrefDevice(const std::string & devID)
 	try {
 		const DeviceProperties & device = _stoppedDevices.at(devID);
 
+		_pGKfs->removeNotifyFile( device.getConfigFilePath() );
 		_pGKfs->removeNotifyWatch( device.getWatchDescriptor() );
 
 		_stoppedDevices.erase(devID);
@@ -736,6 +766,13 @@ void DevicesHandler::setDeviceCurrentBankID(const std::string & devID, const MKe
 		GKLog2(trace, devID, " started device")
 
 		device.setCurrentBankID(bankID);
+
+		try {
+			_actionTables.at(devID).setCurrentBankID(bankID);
+		}
+		catch (const std::out_of_range& oor) {
+			LOG(warning) << devID << " device actions table not found";
+		}
 	}
 	catch (const std::out_of_range& oor) {
 		LOG(warning) << devID << " device not found in started-devices container";
@@ -763,6 +800,45 @@ banksMap_type & DevicesHandler::getDeviceBanks(const std::string & devID, MKeysI
 	}
 }
 
+/* called on each G-Key event, avoid the map lookup when
+ * the same device sends consecutive events */
+const GKeysActionTable* DevicesHandler::getDeviceActionTable(const std::string & devID)
+{
+	if( (_pLastActionTable != nullptr) and (_lastActionTableDevID == devID) )
+		return _pLastActionTable;
+
+	auto it = _actionTables.find(devID);
+	if( it == _actionTables.end() ) {
+		LOG(warning) << devID << " device not found in started-devices container";
+		return nullptr;
+	}
+
+	_lastActionTableDevID = devID;
+	_pLastActionTable = &(it->second);
+
+	return _pLastActionTable;
+}
+
+void DevicesHandler::buildDeviceActionTable(
+	const std::string & devID,
+	const DeviceProperties & device)
+{
+	GK_LOG_FUNC
+
+	GKLog2(trace, devID, " building G-Keys actions table")
+
+	/* std::map nodes are stable, cached pointer stays valid */
+	_actionTables[devID].build(device.getBanks(), device.getCurrentBankID());
+}
+
+void DevicesHandler::eraseDeviceActionTable(const std::string & devID)
+{
+	if(_lastActionTableDevID == devID)
+		_pLastActionTable = nullptr;
+
+	_actionTables.erase(devID);
+}
+
 void DevicesHandler::doDeviceFakeKeyEvent(
 	const std::string & devID,
 	const std::string & mediaKeyEvent)
@@ -795,6 +871,7 @@ void DevicesHandler::doDeviceFakeKeyEvent(
 		XTestFakeKeyEvent(dpy, code, True, 0);
 		XTestFakeKeyEvent(dpy, code, False, 0);
 		XFlush(dpy);
+		LatencyProbe::mark(LatencyFlow::LATENCY_MEDIA, LatencyStage::STAGE_OUTPUT);
 
 		XCloseDisplay(dpy);
 
@@ -837,6 +914,45 @@ const LCDPPArray_type &
 	return DeviceProperties::_LCDPluginsPropertiesEmptyArray;
 }
 
+/* forward device metrics from daemon, see ClientsManager::getDeviceMetrics */
+const std::vector<std::string> DevicesHandler::getDeviceMetrics(const std::string & devID)
+{
+	GK_LOG_FUNC
+
+	std::vector<std::string> ret;
+
+	const std::string remoteMethod("GetDeviceMetrics");
+
+	try {
+		DBus.initializeRemoteMethodCall(
+			_systemBus,
+			GLOGIK_DAEMON_DBUS_BUS_CONNECTION_NAME,
+			GLOGIK_DAEMON_DEVICES_MANAGER_DBUS_OBJECT_PATH,
+			GLOGIK_DAEMON_DEVICES_MANAGER_DBUS_INTERFACE,
+			remoteMethod.c_str()
+		);
+		DBus.appendStringToRemoteMethodCall(_clientID);
+		DBus.appendStringToRemoteMethodCall(devID);
+
+		DBus.sendRemoteMethodCall();
+
+		try {
+			DBus.waitForRemoteMethodCallReply();
+
+			ret = DBus.getNextStringArray();
+		}
+		catch (const GLogiKExcept & e) {
+			LogRemoteCallGetReplyFailure
+		}
+	}
+	catch (const GKDBusMessageWrongBuild & e) {
+		DBus.abandonRemoteMethodCall();
+		LogRemoteCallFailure
+	}
+
+	return ret;
+}
+
 const MKeysIDArray_type DevicesHandler::getDeviceMKeysIDArray(const std::string & devID)
 {
 	MKeysIDArray_type MKeysIDArray;
@@ -42,6 +42,7 @@
 #include "include/LCDPP.hpp"
 
 #include "DBus.hpp"
+#include "GKeysActionTable.hpp"
 
 #include <config.h>
 
@@ -73,19 +74,20 @@ class DevicesHandler
 
 		void setDeviceCurrentBankID(const std::string & devID, const MKeysID bankID);
 		banksMap_type & getDeviceBanks(const std::string & devID, MKeysID & bankID);
+		const GKeysActionTable* getDeviceActionTable(const std::string & devID);
 
 		void doDeviceFakeKeyEvent(
 			const std::string & devID,
 			const std::string & mediaKeyEvent
 		);
 
-		const DevicesFilesMap_type getDevicesFilesMap(void);
 		const std::vector<std::string> getDevicesList(void);
 		const LCDPPArray_type & getDeviceLCDPluginsProperties(
 			const std::string & devID
 		);
+		const std::vector<std::string> getDeviceMetrics(const std::string & devID);
 
-		void reloadDeviceConfigurationFile(const std::string & devID);
+		const uint8_t reloadDeviceConfigurationFile(const std::string & devID);
 		void saveDeviceConfigurationFile(const std::string & devID);
 
 	protected:
@@ -100,11 +102,20 @@ class DevicesHandler
 
 		typedef std::set<std::string> devIDSet;
 
+		/* ConfigurationChange mask, everything sent */
+		static constexpr uint8_t _allChanges = 0xFF;
+
 		devIDSet _ignoredFSNotifications;
 
 		std::map<std::string, DeviceProperties> _startedDevices;
 		std::map<std::string, DeviceProperties> _stoppedDevices;
 
+		/* flat G-Keys actions tables for started devices, rebuilt
+		 * each time the device configuration changes */
+		std::map<std::string, GKeysActionTable> _actionTables;
+		std::string _lastActionTableDevID;
+		GKeysActionTable* _pLastActionTable;
+
 #if HAVE_DESKTOP_NOTIFICATIONS
 		void showNotification(
 			const std::string & devID,
@@ -131,12 +142,22 @@ class DevicesHandler
 
 		void sendDeviceConfigurationToDaemon(
 			const std::string & devID,
-			const DeviceProperties & device
+			const DeviceProperties & device,
+			const uint8_t changes = _allChanges
+		);
+		void sendDeviceConfigurationSavedSignal(
+			const std::string & devID,
+			const uint8_t changes = _allChanges
 		);
-		void sendDeviceConfigurationSavedSignal(const std::string & devID);
 
 		void unrefDevice(const std::string & devID);
 
+		void buildDeviceActionTable(
+			const std::string & devID,
+			const DeviceProperties & device
+		);
+		void eraseDeviceActionTable(const std::string & devID);
+
 		const bool checkDeviceCapability(const DeviceProperties & device, Caps toCheck);
 
 		const MKeysIDArray_type getDeviceMKeysIDArray(const std::string & devID);
@@ -76,6 +76,10 @@ void InitLog::parseCommandLine(const int& argc, char *argv[])
 	desc.add_options()
 		("version,v", po::bool_switch()->default_value(false),
 		 "print some versions informations and exit")
+		("latency-file,L", po::value<std::string>(),
+		 "record key events latency probes to this file")
+		("trace-file,t", po::value<std::string>(),
+		 "enable hot-path tracing, exported to this trace-event JSON file on exit or SIGUSR2")
 	;
 
 #if DEBUGGING_ON
@@ -93,6 +97,14 @@ void InitLog::parseCommandLine(const int& argc, char *argv[])
 			GKLogging::GKDebug = true;
 		}
 #endif
+
+	if( _vm.count("latency-file") ) {
+		LatencyProbe::open( _vm["latency-file"].as<std::string>() ); /* throws on failure */
+	}
+
+	if( _vm.count("trace-file") ) {
+		GKTrace::enable( _vm["trace-file"].as<std::string>() ); /* throws on failure */
+	}
 }
 
 } // namespace GLogiK
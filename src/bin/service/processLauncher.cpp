@@ -0,0 +1,239 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/signalfd.h>
+
+#include <sstream>
+
+#include "lib/utils/utils.hpp"
+
+#include "processLauncher.hpp"
+
+extern char **environ;
+
+namespace GLogiK
+{
+
+using namespace NSGKUtils;
+
+std::map<std::string, std::string> ProcessLauncher::executablesCache;
+std::string ProcessLauncher::cachedPATH;
+
+ProcessLauncher::ProcessLauncher(void)
+	:	_signalFD(-1),
+		_spawned(0),
+		_failed(0),
+		_exited(0),
+		_nonZeroExits(0),
+		_lastExitStatus(0)
+{
+	GK_LOG_FUNC
+
+	/* SIGCHLD is ignored since process::detach(), restore default
+	 * action so that children are not automatically reaped, and
+	 * block it to receive it through signalfd */
+	process::resetSignalHandler(SIGCHLD);
+
+	sigset_t mask;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+
+	if(sigprocmask(SIG_BLOCK, &mask, nullptr) == -1) {
+		LOG(error) << "sigprocmask failure : " << strerror(errno);
+		throw GLogiKExcept("failed to block SIGCHLD");
+	}
+
+	_signalFD = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+	if(_signalFD == -1) {
+		LOG(error) << "signalfd failure : " << strerror(errno);
+		throw GLogiKExcept("failed to create SIGCHLD descriptor");
+	}
+}
+
+ProcessLauncher::~ProcessLauncher(void)
+{
+	GK_LOG_FUNC
+
+	this->reapChildren();
+
+	if( ! _children.empty() ) {
+		GKLog2(trace, "children still running : ", _children.size())
+	}
+
+	if(_signalFD != -1)
+		close(_signalFD);
+}
+
+const int ProcessLauncher::getSignalDescriptor(void) const
+{
+	return _signalFD;
+}
+
+void ProcessLauncher::checkPATH(void)
+{
+	const char* path = std::getenv("PATH");
+	const char* current = (path == nullptr) ? "" : path;
+
+	if( cachedPATH != current ) {
+		GKLog(trace, "PATH changed, clearing executables cache")
+		executablesCache.clear();
+		cachedPATH = current;
+	}
+}
+
+/* return the full path of the executable, or an empty string */
+const std::string & ProcessLauncher::searchPath(const std::string & exe)
+{
+	GK_LOG_FUNC
+
+	ProcessLauncher::checkPATH();
+
+	auto it = executablesCache.find(exe);
+	if( it != executablesCache.end() )
+		return it->second;
+
+	std::string & fullPath = executablesCache[exe];
+
+	if( exe.find('/') != std::string::npos ) {
+		if( access(exe.c_str(), X_OK) == 0 )
+			fullPath = exe;
+		return fullPath;
+	}
+
+	std::istringstream tmpstream(cachedPATH);
+	std::string dir;
+	while( std::getline(tmpstream, dir, ':') ) {
+		if( dir.empty() )
+			dir = ".";
+
+		std::string candidate(dir);
+		candidate += "/";
+		candidate += exe;
+
+		if( access(candidate.c_str(), X_OK) == 0 ) {
+			fullPath = candidate;
+			break;
+		}
+	}
+
+	GKLog4(trace, "resolved executable: ", exe, "path: ", fullPath)
+
+	return fullPath;
+}
+
+void ProcessLauncher::spawn(
+	const std::string & exe,
+	const std::vector<std::string> & args)
+{
+	GK_LOG_FUNC
+
+	const std::string & path = ProcessLauncher::searchPath(exe);
+	if( path.empty() ) {
+		LOG(error) << exe << " executable not found in PATH";
+		_failed++;
+		return;
+	}
+
+	/* argv buffer reused between calls */
+	_argv.clear();
+	_argv.push_back( const_cast<char*>(exe.c_str()) );
+	for(const auto & arg : args) {
+		_argv.push_back( const_cast<char*>(arg.c_str()) );
+	}
+	_argv.push_back(nullptr);
+
+	/* children must not inherit the blocked SIGCHLD */
+	posix_spawnattr_t attr;
+	posix_spawnattr_init(&attr);
+
+	sigset_t mask;
+	sigemptyset(&mask);
+	posix_spawnattr_setsigmask(&attr, &mask);
+	posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+	pid_t pid = 0;
+	const int ret = posix_spawn(&pid, path.c_str(), nullptr, &attr, _argv.data(), environ);
+
+	posix_spawnattr_destroy(&attr);
+
+	if(ret != 0) {
+		LOG(error) << "failed to spawn process: " << path << " : " << strerror(ret);
+		_failed++;
+		return;
+	}
+
+	_children[pid] = exe;
+	_spawned++;
+
+	GKLog4(trace, "spawned: ", path, "pid: ", pid)
+}
+
+void ProcessLauncher::reapChildren(void)
+{
+	GK_LOG_FUNC
+
+	/* drain pending signals, several SIGCHLD may be merged into one */
+	struct signalfd_siginfo info;
+	while( read(_signalFD, &info, sizeof(info)) == sizeof(info) ) {
+	}
+
+	int status = 0;
+	pid_t pid = 0;
+	while( (pid = waitpid(-1, &status, WNOHANG)) > 0 ) {
+		_exited++;
+
+		if( WIFEXITED(status) )
+			_lastExitStatus = WEXITSTATUS(status);
+		else if( WIFSIGNALED(status) )
+			_lastExitStatus = 128 + WTERMSIG(status);
+
+		if(_lastExitStatus != 0)
+			_nonZeroExits++;
+
+		auto it = _children.find(pid);
+		if( it != _children.end() ) {
+			GKLog4(trace, "reaped child: ", it->second, "exit status: ", _lastExitStatus)
+			_children.erase(it);
+		}
+	}
+}
+
+const std::vector<std::string> ProcessLauncher::getStats(void) const
+{
+	std::vector<std::string> ret;
+	ret.push_back( std::to_string(_children.size()) );	/* in-flight */
+	ret.push_back( std::to_string(_spawned) );
+	ret.push_back( std::to_string(_failed) );
+	ret.push_back( std::to_string(_exited) );
+	ret.push_back( std::to_string(_nonZeroExits) );
+	ret.push_back( std::to_string(_lastExitStatus) );
+	return ret;
+}
+
+} // namespace GLogiK
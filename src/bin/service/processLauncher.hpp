@@ -0,0 +1,78 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_BIN_SERVICE_PROCESS_LAUNCHER_HPP_
+#define SRC_BIN_SERVICE_PROCESS_LAUNCHER_HPP_
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include <sys/types.h>
+
+namespace GLogiK
+{
+
+class ProcessLauncher
+{
+	public:
+		ProcessLauncher(void);
+		~ProcessLauncher(void);
+
+		static const std::string & searchPath(const std::string & exe);
+
+		void spawn(
+			const std::string & exe,
+			const std::vector<std::string> & args
+		);
+
+		const int getSignalDescriptor(void) const;
+		void reapChildren(void);
+
+		const std::vector<std::string> getStats(void) const;
+
+	protected:
+
+	private:
+		/* PATH resolution cache, dropped when PATH changes */
+		static std::map<std::string, std::string> executablesCache;
+		static std::string cachedPATH;
+
+		int _signalFD;
+
+		/* in-flight children and their commands */
+		std::map<pid_t, std::string> _children;
+		std::vector<char*> _argv;
+
+		uint64_t _spawned;
+		uint64_t _failed;
+		uint64_t _exited;
+		uint64_t _nonZeroExits;
+		int _lastExitStatus;
+
+		static void checkPATH(void);
+};
+
+} // namespace GLogiK
+
+#endif
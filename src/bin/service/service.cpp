@@ -114,8 +114,8 @@ int DesktopService::run(void)
 		DBus.connectToSystemBus(GLOGIK_DESKTOP_SERVICE_DBUS_BUS_CONNECTION_NAME);
 		DBus.connectToSessionBus(GLOGIK_DESKTOP_SERVICE_DBUS_BUS_CONNECTION_NAME);
 
-		struct pollfd fds[2];
-		nfds_t nfds = 2;
+		struct pollfd fds[3];
+		nfds_t nfds = 3;
 
 		fds[0].fd = session.openConnection();
 		fds[0].events = POLLIN;
@@ -125,6 +125,9 @@ int DesktopService::run(void)
 
 		DBusHandler handler(_pid, &GKfs, &dependencies);
 
+		fds[2].fd = handler.getChildrenSignalDescriptor();
+		fds[2].events = POLLIN;
+
 		while( session.isSessionAlive() and
 				handler.getExitStatus() )
 		{
@@ -143,9 +146,15 @@ int DesktopService::run(void)
 					 * and send configuration to daemon */
 					handler.checkNotifyEvents(&GKfs);
 				}
+
+				if( fds[2].revents & POLLIN ) {
+					handler.checkChildrenSignals();
+				}
 			}
 
 			DBus.checkForMessages();
+
+			GKTrace::checkDumpRequest();
 		}
 
 		// also unregister with daemon before cleaning
@@ -25,6 +25,9 @@
 #include <chrono>
 
 #include <cstring>
+#include <cerrno>
+
+#include <unistd.h>
 
 #include "lib/utils/utils.hpp"
 #include "lib/shared/glogik.hpp"
@@ -134,5 +137,19 @@ void VirtualKeyboard::sendKeyEvent(const KeyEvent & key)
 	}
 }
 
+/* events are expected to be already decoded, EV_SYN included */
+void VirtualKeyboard::sendKeyEvents(const std::vector<input_event> & events)
+{
+	if( events.empty() )
+		return;
+
+	const ssize_t size = events.size() * sizeof(input_event);
+	const ssize_t ret = write(libevdev_uinput_get_fd(_pUInputDevice), events.data(), size);
+	if(ret != size) {
+		const int write_errno = errno;
+		LOG(warning) << "uinput write_events : " << ret << "/" << size << " : " << strerror(write_errno);
+	}
+}
+
 } // namespace GLogiK
 
@@ -23,6 +23,9 @@
 #define SRC_BIN_SERVICE_VIRTUAL_KEYBOARD_HPP_
 
 #include <string>
+#include <vector>
+
+#include <linux/input.h>
 
 #include <libevdev/libevdev.h>
 #include <libevdev/libevdev-uinput.h>
@@ -39,6 +42,7 @@ class VirtualKeyboard
 		~VirtualKeyboard(void);
 
 		void sendKeyEvent(const KeyEvent & key);
+		void sendKeyEvents(const std::vector<input_event> & events);
 
 	protected:
 	private:
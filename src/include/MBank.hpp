@@ -75,6 +75,12 @@ class GKeysEvent
 			_GKeyCommand.clear();
 		}
 
+		const bool operator == (const GKeysEvent & other) const {
+			return (	(_GKeyEventType == other._GKeyEventType) and
+						(_GKeyMacro == other._GKeyMacro) and
+						(_GKeyCommand == other._GKeyCommand) );
+		}
+
 	private:
 		macro_type _GKeyMacro;
 		std::string _GKeyCommand;
@@ -60,6 +60,10 @@ struct KeyEvent {
 		KeyEvent(uint8_t c=KEY_UNKNOWN, EventValue e=EventValue::EVENT_KEY_UNKNOWN, uint16_t i=0)
 			: code(c), event(e), interval(i) {}
 
+		const bool operator == (const KeyEvent & other) const {
+			return ( (code == other.code) and (event == other.event) and (interval == other.interval) );
+		}
+
 	private:
 		friend class boost::serialization::access;
 
@@ -109,6 +109,14 @@ inline Caps operator | (Caps lhs, Caps rhs)
 	return (Caps)(static_cast<T>(lhs) | static_cast<T>(rhs));
 }
 
+/* configuration changes detected when reloading configuration files */
+enum class ConfigurationChange : uint8_t
+{
+	GK_CONFIG_BACKLIGHT_COLOR	= 1 << 0,
+	GK_CONFIG_LCD_PLUGINS_MASK	= 1 << 1,
+	GK_CONFIG_GKEYS_BANKS		= 1 << 2,
+};
+
 enum class LCDScreenPlugin : uint64_t
 {
 	GK_LCD_SPLASHSCREEN		= one << 0,
@@ -34,6 +34,7 @@ thread_local std::vector<uint8_t> ArgBase::byteArguments = {};
 thread_local std::vector<uint16_t> ArgBase::uint16Arguments = {};
 thread_local std::vector<uint64_t> ArgBase::uint64Arguments = {};
 thread_local std::vector<bool> ArgBase::booleanArguments = {};
+thread_local std::map<std::string, std::string> ArgBase::propertiesArguments = {};
 
 void ArgBase::decodeArgumentFromIterator(
 	DBusMessageIter* iter,
@@ -181,6 +182,79 @@ void ArgBase::decodeArgumentFromIterator(
 				dbus_free(sig);
 			}
 			break;
+		case DBUS_TYPE_DICT_ENTRY:
+			{
+				/* -
+				 * dictionary entries are only expected from a{sv} properties
+				 * dictionaries sent by other programs (PropertiesChanged signal).
+				 * basic variant values are stored as strings into a separate
+				 * container, see ArgProperties::getNextPropertiesArgument()
+				 */
+				DBusMessageIter itEntry;
+				dbus_message_iter_recurse(iter, &itEntry);
+				if(dbus_message_iter_get_arg_type(&itEntry) != DBUS_TYPE_STRING) {
+					LOG(error) << "unhandled dictionary key type, sig: " << signature;
+					break;
+				}
+
+				const char* key = nullptr;
+				dbus_message_iter_get_basic(&itEntry, &key);
+
+				if( ! dbus_message_iter_next(&itEntry) ) {
+					LOG(error) << "missing dictionary value, key: " << key;
+					break;
+				}
+
+				DBusMessageIter itValue;
+				if(dbus_message_iter_get_arg_type(&itEntry) == DBUS_TYPE_VARIANT)
+					dbus_message_iter_recurse(&itEntry, &itValue);
+				else
+					itValue = itEntry;
+
+				std::string value;
+				bool basicValue = true;
+				switch( dbus_message_iter_get_arg_type(&itValue) ) {
+					case DBUS_TYPE_STRING:
+					case DBUS_TYPE_OBJECT_PATH:
+						{
+							const char* v = nullptr;
+							dbus_message_iter_get_basic(&itValue, &v);
+							value = v;
+						}
+						break;
+					case DBUS_TYPE_BOOLEAN:
+						{
+							dbus_bool_t v = false;
+							dbus_message_iter_get_basic(&itValue, &v);
+							value = (v ? "true" : "false");
+						}
+						break;
+					case DBUS_TYPE_UINT32:
+						{
+							uint32_t v = 0;
+							dbus_message_iter_get_basic(&itValue, &v);
+							value = std::to_string(v);
+						}
+						break;
+					case DBUS_TYPE_UINT64:
+						{
+							uint64_t v = 0;
+							dbus_message_iter_get_basic(&itValue, &v);
+							value = std::to_string(v);
+						}
+						break;
+					default:
+						basicValue = false;
+#if DEBUG_GKDBUS
+						LOG(trace) << "skipping non-basic property value, key: " << key;
+#endif
+						break;
+				}
+
+				if(basicValue)
+					ArgBase::propertiesArguments[key] = value;
+			}
+			break;
 		default: // other dbus type
 			LOG(error) << "unhandled argument type: " << static_cast<char>(currentType) << " sig: " << signature;
 			break;
@@ -196,6 +270,7 @@ void ArgBase::fillInArguments(DBusMessage* message)
 	ArgBase::byteArguments.clear();
 	ArgBase::uint16Arguments.clear();
 	ArgBase::uint64Arguments.clear();
+	ArgBase::propertiesArguments.clear();
 
 	if(message == nullptr) {
 		LOG(warning) << "message is NULL";
@@ -232,6 +307,7 @@ const int ArgBase::decodeNextArgument(DBusMessageIter* itArgument)
 	ArgBase::byteArguments.clear();
 	ArgBase::uint16Arguments.clear();
 	ArgBase::uint64Arguments.clear();
+	ArgBase::propertiesArguments.clear();
 
 	int currentType = dbus_message_iter_get_arg_type(itArgument);
 	if(currentType == DBUS_TYPE_INVALID) /* no more arguments, or struct or array */
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <string>
 #include <vector>
+#include <map>
 
 #include <dbus/dbus.h>
 
@@ -50,6 +51,7 @@ class ArgBase
 		thread_local static std::vector<uint16_t> uint16Arguments;
 		thread_local static std::vector<uint64_t> uint64Arguments;
 		thread_local static std::vector<bool> booleanArguments;
+		thread_local static std::map<std::string, std::string> propertiesArguments;
 
 		template<typename T, typename A>
 		static void reverse(std::vector<T, A> & ctn)
@@ -0,0 +1,63 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "lib/utils/utils.hpp"
+
+#include "properties.hpp"
+
+namespace NSGKDBus
+{
+
+using namespace NSGKUtils;
+
+const GKDBusProperties_type ArgProperties::getNextPropertiesArgument(void)
+{
+	GK_LOG_FUNC
+
+	GKDBusProperties_type ret;
+	ret.swap(ArgBase::propertiesArguments);
+
+	GKLog2(trace, "returning properties map size: ", ret.size())
+
+	return ret;
+}
+
+/*
+ * the invalidated properties array is not prefixed by its
+ * size (message not sent with libGKDBus), so all remaining
+ * string arguments are returned
+ */
+const std::vector<std::string> ArgProperties::getNextInvalidatedPropertiesArgument(void)
+{
+	GK_LOG_FUNC
+
+	std::vector<std::string> ret;
+
+	while( ! ArgBase::stringArguments.empty() ) {
+		ret.push_back( ArgString::getNextStringArgument() );
+	}
+
+	GKLog2(trace, "returning invalidated properties size: ", ret.size())
+
+	return ret;
+}
+
+} // namespace NSGKDBus
@@ -0,0 +1,62 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SRC_LIB_DBUS_ARG_GKDBUS_ARGTYPES_PROPERTIES_HPP_
+#define SRC_LIB_DBUS_ARG_GKDBUS_ARGTYPES_PROPERTIES_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "ArgBase.hpp"
+#include "uint64.hpp"
+#include "string.hpp"
+
+namespace NSGKDBus
+{
+
+/* property name, basic value converted to string */
+typedef std::map<std::string, std::string> GKDBusProperties_type;
+
+/*
+ * decoding org.freedesktop.DBus.Properties.PropertiesChanged
+ * arguments (sa{sv}as) sent by other programs
+ */
+class ArgProperties
+	:	virtual protected ArgBase,
+		virtual private ArgUInt64,
+		virtual private ArgString
+{
+	public:
+		static const GKDBusProperties_type getNextPropertiesArgument(void);
+		static const std::vector<std::string> getNextInvalidatedPropertiesArgument(void);
+
+	protected:
+		ArgProperties(void) = default;
+		~ArgProperties(void) = default;
+
+	private:
+
+};
+
+} // namespace NSGKDBus
+
+#endif
@@ -324,6 +324,7 @@ void GKDBus::checkForBusMessages(
 		}
 
 		try {
+			GKTrace::Scope trace(TraceEventID::TRACE_DBUS_DISPATCH);
 			this->checkDBusMessage(connection, message);
 		}
 		catch (const std::out_of_range& oor) {
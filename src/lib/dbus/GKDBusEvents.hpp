@@ -48,9 +48,12 @@ class GKDBusEvents
 		public Callback<SIGsG2v>,
 		public Callback<SIGsGM2v>,
 		public Callback<SIGsm2v>,
+		public Callback<SIGspas2v>,
+		public Callback<SIGsy2v>,
 		public Callback<SIGss2aG>,
 		public Callback<SIGss2am>,
 		public Callback<SIGss2aP>,
+		public Callback<SIGss2as>,
 		public Callback<SIGss2b>,
 		public Callback<SIGss2s>,
 		public Callback<SIGss2v>,
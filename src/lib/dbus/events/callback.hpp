@@ -44,6 +44,7 @@
 // "B" - Bank (mBank_type)
 // "P" - LCD Plugins Properties
 // "D" - GKDepsMap_type
+// "p" - properties map (a{sv} received from other programs)
 
 #include "SIGas2v.hpp"    //         array of string to void
 #include "SIGb2v.hpp"     //                    bool to void
@@ -56,9 +57,12 @@
 #include "SIGsG2v.hpp"    // one string one G-KeyID to void
 #include "SIGsGM2v.hpp"   // one string one G-KeyID one macro to void
 #include "SIGsm2v.hpp"    // one string one M-KeyID to void
+#include "SIGspas2v.hpp"  // one string one properties map one array of string to void
+#include "SIGsy2v.hpp"    //  one string one byte to void
 #include "SIGss2aG.hpp"   //  two strings to array of G-KeyID
 #include "SIGss2am.hpp"   //  two strings to array of M-KeyID
 #include "SIGss2aP.hpp"   //  two strings to array of LCD Plugins Properties
+#include "SIGss2as.hpp"   //  two strings to array of string
 #include "SIGss2b.hpp"    //             two strings to bool
 #include "SIGss2s.hpp"    //           two strings to string
 #include "SIGss2v.hpp"    //             two strings to void
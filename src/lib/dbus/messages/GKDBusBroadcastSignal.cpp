@@ -182,7 +182,8 @@ void GKDBusMessageBroadcastSignal::sendBroadcastSignal(void)
 	GK_LOG_FUNC
 
 	if(_signal) { /* sanity check */
-		delete _signal;
+		GKTrace::Scope trace(TraceEventID::TRACE_DBUS_SIGNAL_EMIT);
+		delete _signal; /* signal sent on destruction */
 		_signal = nullptr;
 	}
 	else {
@@ -183,6 +183,8 @@ void GKDBusMessageRemoteMethodCall::sendRemoteMethodCall(void)
 	GK_LOG_FUNC
 
 	if(_remoteMethodCall) { /* sanity check */
+		_sendTimePoint = std::chrono::steady_clock::now();
+		/* message is sent on destruction */
 		delete _remoteMethodCall;
 		_remoteMethodCall = nullptr;
 	}
@@ -212,6 +214,8 @@ void GKDBusMessageRemoteMethodCall::waitForRemoteMethodCallReply(void)
 
 	dbus_pending_call_block(_pendingCall);
 
+	_roundTrips.add(std::chrono::steady_clock::now() - _sendTimePoint);
+
 	uint16_t c = 0;
 
 	DBusMessage* message = nullptr;
@@ -25,9 +25,12 @@
 #include <cstdint>
 
 #include <string>
+#include <chrono>
 
 #include <dbus/dbus.h>
 
+#include "lib/utils/utils.hpp"
+
 #include "include/base.hpp"
 #include "include/MBank.hpp"
 #include "lib/dbus/GKDBusConnection.hpp"
@@ -83,6 +86,11 @@ class GKDBusMessageRemoteMethodCall
 
 		void waitForRemoteMethodCallReply(void);
 
+		/* send to reply durations of remote method calls */
+		const NSGKUtils::MetricsHistogram & getRemoteMethodCallsRoundTrips(void) const {
+			return _roundTrips;
+		}
+
 	protected:
 		GKDBusMessageRemoteMethodCall();
 		~GKDBusMessageRemoteMethodCall();
@@ -100,6 +108,9 @@ class GKDBusMessageRemoteMethodCall
 		GKDBusRemoteMethodCall* _remoteMethodCall;
 		DBusPendingCall* _pendingCall;
 
+		std::chrono::steady_clock::time_point _sendTimePoint;
+		NSGKUtils::MetricsHistogram _roundTrips;
+
 		virtual DBusConnection* const getDBusConnection(BusConnection wantedConnection) const = 0;
 };
 
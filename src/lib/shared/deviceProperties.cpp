@@ -156,6 +156,28 @@ void DeviceProperties::setProperties(const DeviceProperties & dev)
 	}
 }
 
+/*
+ * returns a mask of ConfigurationChange bits,
+ * comparing this configuration with the given one
+ */
+const uint8_t DeviceProperties::getConfigurationChanges(const DeviceProperties & dev) const
+{
+	uint8_t ret = 0;
+
+	uint8_t r = 0, g = 0, b = 0;
+	dev.getRGBBytes(r, g, b);
+	if( (r != _red) or (g != _green) or (b != _blue) )
+		ret |= toEnumType(ConfigurationChange::GK_CONFIG_BACKLIGHT_COLOR);
+
+	if( dev.getLCDPluginsMask1() != _LCDPluginsMask1 )
+		ret |= toEnumType(ConfigurationChange::GK_CONFIG_LCD_PLUGINS_MASK);
+
+	if( dev.getBanks() != _GKeysBanks )
+		ret |= toEnumType(ConfigurationChange::GK_CONFIG_GKEYS_BANKS);
+
+	return ret;
+}
+
 /* -- -- -- */
 } // namespace GLogiK
 
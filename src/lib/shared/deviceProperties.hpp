@@ -156,6 +156,8 @@ class DeviceProperties
 
 		void setProperties(const DeviceProperties & dev);
 
+		const uint8_t getConfigurationChanges(const DeviceProperties & dev) const;
+
 	protected:
 	private:
 		int _watchedDescriptor;
@@ -88,6 +88,10 @@ c_str MUTE_MICRO	= "";
 
 /* --- ---- --- */
 
+c_str GLOGIK_UDEV_TAG = "glogik";
+
+/* --- ---- --- */
+
 const std::map<Keys, c_str> keysNamesMap = {
 	{ Keys::GK_KEY_M1, M_KEY_M1 },
 	{ Keys::GK_KEY_M2, M_KEY_M2 },
@@ -219,6 +223,32 @@ const GKeysID getGKeyID(const Keys key)
 	return keys2GKeysIDMap.at(key);
 }
 
+const SessionState toSessionState(const std::string & state)
+{
+	if(state == "active")
+		return SessionState::SESSION_ACTIVE;
+	if(state == "online")
+		return SessionState::SESSION_ONLINE;
+	if(state == "closing")
+		return SessionState::SESSION_CLOSING;
+	return SessionState::SESSION_UNKNOWN;
+}
+
+c_str toSessionStateString(const SessionState state)
+{
+	switch(state) {
+		case SessionState::SESSION_ACTIVE:
+			return "active";
+		case SessionState::SESSION_ONLINE:
+			return "online";
+		case SessionState::SESSION_CLOSING:
+			return "closing";
+		default:
+			break;
+	}
+	return "unknown";
+}
+
 void printVersionDeps(const std::string & binaryVersion, const GKDepsMap_type & dependencies)
 {
 	using namespace NSGKUtils;
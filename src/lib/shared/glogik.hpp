@@ -108,6 +108,11 @@ void printVersionDeps(const std::string & binaryVersion, const GKDepsMap_type &
 
 /* --- ---- --- */
 
+/* udev tag added to supported devices by GLogiK udev rules */
+extern c_str GLOGIK_UDEV_TAG;
+
+/* --- ---- --- */
+
 /* --- ---- --- *
  * -- GKDBus -- *
  * --- ---- --- */
@@ -163,6 +168,18 @@ enum class SessionFramework : uint8_t
 	FW_LOGIND,
 };
 
+/* logind session states */
+enum class SessionState : uint8_t
+{
+	SESSION_UNKNOWN = 0,
+	SESSION_ONLINE,
+	SESSION_ACTIVE,
+	SESSION_CLOSING,
+};
+
+const SessionState toSessionState(const std::string & state);
+c_str toSessionStateString(const SessionState state);
+
 } // namespace GLogiK
 
 #endif
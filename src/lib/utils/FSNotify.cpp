@@ -25,7 +25,7 @@
 #include <cstdint>
 #include <unistd.h>
 
-#include <set>
+#include <vector>
 #include <sstream>
 
 #include <sys/inotify.h>
@@ -64,9 +64,12 @@ FSNotify::~FSNotify()
 	if( ! _watchedDescriptorsMap.empty() ) {
 		LOG(warning) << "some watch descriptors were not removed";
 		for(const auto & watchedPair : _watchedDescriptorsMap) {
-			this->removeNotifyWatch(watchedPair.second.wd);
+			if( inotify_rm_watch(_inotifyQueueFD, watchedPair.second.wd) == -1 ) {
+				LOG(error) << "inotify rm watch failure : " << strerror(errno);
+			}
 		}
 		_watchedDescriptorsMap.clear();
+		_watchedPathsMap.clear();
 	}
 
 	/* closing queue */
@@ -107,26 +110,54 @@ void FSNotify::removeNotifyWatch(const int wd)
 		return;
 	}
 
-	const int & fd = _inotifyQueueFD;
-	auto findDescriptor = [&fd, &wd] (auto & item) -> const bool {
-		WatchedObject & watched = item.second;
-		if(watched.wd != wd)
-			return false;
-		--watched.count;
-		if(watched.count == 0) {
-			if( inotify_rm_watch(fd, wd) == -1 ) {
-				LOG(error) << "inotify rm watch failure : " << strerror(errno);
-			}
-			else {
-				GKLog3(trace, wd, " | removed path notify watch", item.first)
-			}
-			return true;
-		}
-		GKLog3(trace, wd, " | decremented reference to path notify watch", item.first)
-		return false;
-	};
+	auto itPath = _watchedPathsMap.find(wd);
+	if(itPath == _watchedPathsMap.end()) {
+		GKLog2(trace, wd, " | watch descriptor not found")
+		return;
+	}
 
-	erase_if(_watchedDescriptorsMap, findDescriptor);
+	auto it = _watchedDescriptorsMap.find((*itPath).second);
+	if(it == _watchedDescriptorsMap.end()) {
+		LOG(error) << "[" << wd << "] - watched path not found : " << (*itPath).second;
+		_watchedPathsMap.erase(itPath);
+		return;
+	}
+
+	WatchedObject & watched = (*it).second;
+	--watched.count;
+	if(watched.count > 0) {
+		GKLog3(trace, wd, " | decremented reference to path notify watch", (*it).first)
+		return;
+	}
+
+	if( inotify_rm_watch(_inotifyQueueFD, wd) == -1 ) {
+		LOG(error) << "inotify rm watch failure : " << strerror(errno);
+	}
+	else {
+		GKLog3(trace, wd, " | removed path notify watch", (*it).first)
+	}
+
+	_watchedDescriptorsMap.erase(it);
+	_watchedPathsMap.erase(itPath);
+}
+
+/* files inside watched directories, used to map events to devices */
+void FSNotify::addNotifyFile(const std::string & fileName, const std::string & devID)
+{
+	GK_LOG_FUNC
+
+	GKLog3(trace, devID, " | watching file : ", fileName)
+
+	_watchedFilesMap[fileName] = devID;
+}
+
+void FSNotify::removeNotifyFile(const std::string & fileName)
+{
+	GK_LOG_FUNC
+
+	if( _watchedFilesMap.erase(fileName) == 0 ) {
+		GKLog2(trace, "file not watched : ", fileName)
+	}
 }
 
 const int FSNotify::getNotifyQueueDescriptor(void) const
@@ -134,7 +165,12 @@ const int FSNotify::getNotifyQueueDescriptor(void) const
 	return _inotifyQueueFD;
 }
 
-void FSNotify::readNotifyEvents(DevicesFilesMap_type & filesMap)
+/*
+ * Each event is mapped to its device through the file name index.
+ * Bursts of events on the same file are coalesced since devices IDs
+ * are collected into a set, so each device is reloaded only once.
+ */
+void FSNotify::readNotifyEvents(NotifiedDevices_type & devicesID)
 {
 	GK_LOG_FUNC
 
@@ -143,7 +179,7 @@ void FSNotify::readNotifyEvents(DevicesFilesMap_type & filesMap)
 	char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
 	const struct inotify_event *event;
 
-	std::set<std::string> toRemove;
+	std::vector<int> toRemove;
 
 	for (;;) {
 		/* Read some events. */
@@ -158,28 +194,22 @@ void FSNotify::readNotifyEvents(DevicesFilesMap_type & filesMap)
 		for (ptr = buf; ptr < buf + len; ptr += sizeof(struct inotify_event) + event->len) {
 			event = (const struct inotify_event *) ptr;
 
-			std::string wd("[");
-			wd += std::to_string(event->wd);
-			wd += "]";
+			const int & wd = event->wd;
 
 			/* file inside watched directory */
 			if (event->len) {
-				const std::string name(event->name);
-				GKLog3(trace, wd, " | name : ", name)
-				/* map size will be 0 or 1 after that */
-				erase_if(filesMap, [&name]( auto & item ) -> const bool { return item.second != name; } );
+				auto it = _watchedFilesMap.find(event->name);
+				if(it == _watchedFilesMap.end()) {
+					GKLog3(trace, wd, " | skip event : unknown file : ", event->name)
+					continue; /* next event */
+				}
+
+				GKLog4(trace, wd, " | name : ", (*it).second, event->name)
+				devicesID.insert((*it).second);
 			}
 			else { /* watched object event */
-				filesMap.clear();
-
-				std::string path;
-				for(const auto & itemPair : _watchedDescriptorsMap) {
-					if(itemPair.second.wd == event->wd) {
-						path = itemPair.first;
-						break;
-					}
-				}
-				if( path.empty() ) {
+				auto it = _watchedPathsMap.find(wd);
+				if( it == _watchedPathsMap.end() ) {
 					/*
 					 * on next readNotifyEvents call IN_IGNORED can be generated by
 					 * current IN_MOVE_SELF since we force remove the watch below
@@ -193,9 +223,11 @@ void FSNotify::readNotifyEvents(DevicesFilesMap_type & filesMap)
 					continue; /* next event */
 				}
 
+				const std::string & path = (*it).second;
+
 				if( event->mask & IN_MOVE_SELF ) {
 					GKLog3(trace, wd, " | [IN_MOVE_SELF] watched object renamed or moved : ", path)
-					toRemove.insert(path);
+					toRemove.push_back(wd);
 				}
 				if( event->mask & IN_DELETE_SELF ) {
 					GKLog3(trace, wd, " | [IN_DELETE_SELF] watched object deleted : ", path)
@@ -203,15 +235,19 @@ void FSNotify::readNotifyEvents(DevicesFilesMap_type & filesMap)
 				if( event->mask & IN_IGNORED ) {
 					GKLog3(trace, wd, " | [IN_IGNORED] watch was removed : ", path)
 					_watchedDescriptorsMap.erase(path);
+					_watchedPathsMap.erase(it);
 				}
 			}
 		}
 
-		for(const auto & path : toRemove) {
-			auto it = _watchedDescriptorsMap.find(path);
-			if(it != _watchedDescriptorsMap.end()) {
-				(*it).second.count = 1; /* force removing watch */
-				this->removeNotifyWatch((*it).second.wd);
+		for(const int wd : toRemove) {
+			auto itPath = _watchedPathsMap.find(wd);
+			if(itPath != _watchedPathsMap.end()) {
+				auto it = _watchedDescriptorsMap.find((*itPath).second);
+				if(it != _watchedDescriptorsMap.end()) {
+					(*it).second.count = 1; /* force removing watch */
+					this->removeNotifyWatch(wd);
+				}
 			}
 		}
 		toRemove.clear();
@@ -242,8 +278,8 @@ const int FSNotify::addNotifyWatch(const std::string & path, const uint32_t & ma
 			throw GLogiKExcept( buffer.str() );
 		}
 
-		_watchedDescriptorsMap.insert( std::pair<const std::string, WatchedObject>(path, WatchedObject(ret)) );
-		it = _watchedDescriptorsMap.find(path);
+		it = _watchedDescriptorsMap.insert( std::pair<const std::string, WatchedObject>(path, WatchedObject(ret)) ).first;
+		_watchedPathsMap[ret] = path;
 
 		GKLog3(trace, (*it).second.wd, " | added path notify watch : ", path)
 	}
@@ -27,22 +27,17 @@
 #endif
 
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <string>
 
-typedef std::map<std::string, const std::string> DevicesFilesMap_type;
+/* file name, device ID */
+typedef std::unordered_map<std::string, std::string> DevicesFilesMap_type;
+typedef std::set<std::string> NotifiedDevices_type;
 
 namespace NSGKUtils
 {
 
-// TODO see std::experimental::erase_if
-template< typename ContainerT, typename PredicateT >
-void erase_if( ContainerT& items, const PredicateT& predicate ) {
-	for( auto it = items.begin(); it != items.end(); ) {
-		if( predicate(*it) ) { it = items.erase(it); }
-		else { ++it; }
-	}
-}
-
 struct WatchedObject {
 	public:
 		const int wd;
@@ -67,9 +62,12 @@ class FSNotify
 		);
 		void removeNotifyWatch(const int wd);
 
+		void addNotifyFile(const std::string & fileName, const std::string & devID);
+		void removeNotifyFile(const std::string & fileName);
+
 		const int getNotifyQueueDescriptor(void) const;
 
-		void readNotifyEvents(DevicesFilesMap_type & filesMap);
+		void readNotifyEvents(NotifiedDevices_type & devicesID);
 
 
 	protected:
@@ -78,6 +76,9 @@ class FSNotify
 
 	private:
 		std::map<std::string, WatchedObject> _watchedDescriptorsMap;
+		/* reverse indexes, used when reading events */
+		std::unordered_map<int, std::string> _watchedPathsMap;
+		DevicesFilesMap_type _watchedFilesMap;
 
 		int _inotifyQueueFD;
 
@@ -0,0 +1,227 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <ctime>
+#include <cstdlib>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <fstream>
+#include <algorithm>
+#include <new>
+
+#include <config.h>
+
+#define UTILS_COMPILATION 1
+
+#include "exception.hpp"
+#include "GKTrace.hpp"
+
+#undef UTILS_COMPILATION
+
+namespace NSGKUtils
+{
+
+std::atomic<bool> GKTrace::_enabled(false);
+std::atomic<bool> GKTrace::_dumpRequested(false);
+std::string GKTrace::_file;
+std::mutex GKTrace::_ringsMutex;
+std::vector<std::shared_ptr<TraceRing>> GKTrace::_rings;
+
+void GKTrace::enable(const std::string & file)
+{
+	std::lock_guard<std::mutex> lock(_ringsMutex);
+
+	if( _enabled )
+		return;
+
+	/* check now that the file can be written */
+	std::ofstream ofs(file, std::ios_base::out | std::ios_base::trunc);
+	if( ! ofs.is_open() )
+		throw GLogiKExcept("failed to open trace file");
+
+	_file = file;
+	_enabled = true;
+
+	std::atexit(GKTrace::exportAtExit);
+}
+
+void GKTrace::checkDumpRequest(void) noexcept
+{
+	if( _dumpRequested.exchange(false) and GKTrace::isEnabled() )
+		GKTrace::exportChromeTrace(_file);
+}
+
+/*
+ * Exports all threads rings as Chrome trace event format,
+ * loadable by chrome://tracing and ui.perfetto.dev
+ */
+void GKTrace::exportChromeTrace(const std::string & file) noexcept
+{
+	std::vector<std::shared_ptr<TraceRing>> rings;
+	{
+		std::lock_guard<std::mutex> lock(_ringsMutex);
+		rings = _rings;
+	}
+
+	std::ofstream ofs(file, std::ios_base::out | std::ios_base::trunc);
+	if( ! ofs.is_open() )
+		return;
+
+	const pid_t pid = getpid();
+	bool first = true;
+
+	ofs << "{\"traceEvents\":[";
+
+	std::vector<TraceRecord> records;
+	records.reserve(TraceRing::size);
+
+	for(const auto & ring : rings) {
+		records.clear();
+
+		const uint64_t head = ring->head.load(std::memory_order_acquire);
+		const uint64_t begin = (head > TraceRing::size) ? (head - TraceRing::size) : 0;
+		for(uint64_t i = begin; i < head; i++) {
+			records.push_back( ring->records[i & (TraceRing::size - 1)] );
+		}
+
+		/* records overwritten by the owner thread while copying */
+		const uint64_t newHead = ring->head.load(std::memory_order_acquire);
+		const uint64_t overwritten = (newHead > (begin + TraceRing::size)) ?
+			(newHead - begin - TraceRing::size) : 0;
+
+		for(std::size_t i = std::min<std::size_t>(overwritten, records.size()); i < records.size(); i++) {
+			const TraceRecord & r = records[i];
+
+			if( ! first )
+				ofs << ",";
+			first = false;
+
+			ofs	<< "\n{\"name\":\"" << GKTrace::getEventName(r.id)
+				<< "\",\"ph\":\"" << static_cast<char>(r.phase)
+				<< "\",\"pid\":" << pid
+				<< ",\"tid\":" << ring->tid
+				<< ",\"ts\":" << (r.timestamp / 1000) << "." << (r.timestamp % 1000) / 100;
+			if(r.phase == TracePhase::TRACE_INSTANT)
+				ofs << ",\"s\":\"t\"";
+			ofs << ",\"args\":{\"arg\":" << r.arg << "}}";
+		}
+	}
+
+	ofs << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	ofs.close();
+
+	rings.clear();
+	GKTrace::pruneExitedThreadsRings();
+}
+
+void GKTrace::push(
+	const TraceEventID id,
+	const TracePhase phase,
+	const int32_t arg) noexcept
+{
+	TraceRing* ring = GKTrace::getThreadRing();
+	if(ring == nullptr)
+		return;
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	/* single producer, only the owner thread writes head */
+	const uint64_t head = ring->head.load(std::memory_order_relaxed);
+	TraceRecord & r = ring->records[head & (TraceRing::size - 1)];
+	r.timestamp = static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+	r.arg = arg;
+	r.id = id;
+	r.phase = phase;
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+TraceRing* GKTrace::getThreadRing(void) noexcept
+{
+	/* owner thread reference, released on thread exit */
+	thread_local std::shared_ptr<TraceRing> ring;
+
+	if( ! ring ) {
+		try {
+			auto newRing = std::make_shared<TraceRing>();
+			newRing->tid = static_cast<int>(syscall(SYS_gettid));
+
+			std::lock_guard<std::mutex> lock(_ringsMutex);
+			_rings.push_back(newRing);
+			ring = std::move(newRing);
+		}
+		catch (const std::bad_alloc& e) {
+			/* tracing disabled for this thread */
+		}
+	}
+
+	return ring.get();
+}
+
+/*
+ * Once exported, rings only referenced by the container belong to
+ * exited threads, they would never get new records. Respawned device
+ * threads and workers would otherwise leak one ring each.
+ */
+void GKTrace::pruneExitedThreadsRings(void) noexcept
+{
+	std::lock_guard<std::mutex> lock(_ringsMutex);
+
+	_rings.erase(
+		std::remove_if(_rings.begin(), _rings.end(),
+			[] (const std::shared_ptr<TraceRing> & ring) -> const bool {
+				return (ring.use_count() == 1);
+			}
+		),
+		_rings.end()
+	);
+}
+
+void GKTrace::exportAtExit(void) noexcept
+{
+	_enabled = false;
+	GKTrace::exportChromeTrace(_file);
+}
+
+const char* GKTrace::getEventName(const TraceEventID id) noexcept
+{
+	switch(id) {
+		case TraceEventID::TRACE_USB_KEYS_TRANSFER:
+			return "USB keys transfer";
+		case TraceEventID::TRACE_USB_LCD_TRANSFER:
+			return "USB LCD transfer";
+		case TraceEventID::TRACE_KEY_DECODE:
+			return "key decode";
+		case TraceEventID::TRACE_LCD_RENDER:
+			return "LCD render";
+		case TraceEventID::TRACE_DBUS_SIGNAL_EMIT:
+			return "D-Bus signal emit";
+		case TraceEventID::TRACE_DBUS_DISPATCH:
+			return "D-Bus dispatch";
+	}
+
+	return "unknown";
+}
+
+} // namespace NSGKUtils
@@ -0,0 +1,159 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SRC_LIB_UTILS_GKTRACE_HPP_
+#define SRC_LIB_UTILS_GKTRACE_HPP_
+
+#if !defined (UTILS_INSIDE_UTILS_H) && !defined (UTILS_COMPILATION)
+#error "Only "utils/utils.hpp" can be included directly, this file may disappear or change contents."
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+
+namespace NSGKUtils
+{
+
+/* static event IDs, see GKTrace::getEventName() */
+enum class TraceEventID : uint8_t
+{
+	TRACE_USB_KEYS_TRANSFER = 0,
+	TRACE_USB_LCD_TRANSFER,
+	TRACE_KEY_DECODE,
+	TRACE_LCD_RENDER,
+	TRACE_DBUS_SIGNAL_EMIT,
+	TRACE_DBUS_DISPATCH,
+};
+
+/* Chrome trace event phases */
+enum class TracePhase : uint8_t
+{
+	TRACE_BEGIN = 'B',
+	TRACE_END = 'E',
+	TRACE_INSTANT = 'i',
+};
+
+struct TraceRecord
+{
+	uint64_t timestamp;		/* CLOCK_MONOTONIC nanoseconds */
+	int32_t arg;
+	TraceEventID id;
+	TracePhase phase;
+};
+
+/*
+ * One ring per thread, written by its owner thread only. When full,
+ * the oldest records are overwritten. Readers copy the records, then
+ * drop the ones that may have been overwritten in the meantime.
+ */
+struct TraceRing
+{
+	static constexpr std::size_t size = 4096;	/* power of two */
+
+	std::array<TraceRecord, size> records;
+	std::atomic<uint64_t> head{0};
+	int tid = 0;
+};
+
+/*
+ * Always compiled in hot-path tracing, disabled by default : a probe
+ * is then a single relaxed atomic load. Once enabled, the rings are
+ * exported as Chrome trace / Perfetto JSON on exit, or on request.
+ */
+class GKTrace
+{
+	public:
+		static void enable(const std::string & file);
+		static const bool isEnabled(void) noexcept {
+			return _enabled.load(std::memory_order_relaxed);
+		}
+
+		static void record(
+			const TraceEventID id,
+			const TracePhase phase,
+			const int32_t arg = 0) noexcept
+		{
+			if( GKTrace::isEnabled() )
+				GKTrace::push(id, phase, arg);
+		}
+
+		/* async-signal-safe, dump done on next ::checkDumpRequest() call */
+		static void requestDump(void) noexcept { _dumpRequested = true; }
+		static void checkDumpRequest(void) noexcept;
+
+		static void exportChromeTrace(const std::string & file) noexcept;
+
+		/* begin and end records for the enclosing scope */
+		class Scope
+		{
+			public:
+				Scope(const TraceEventID id) : _id(id) {
+					GKTrace::record(_id, TracePhase::TRACE_BEGIN);
+				}
+				~Scope(void) {
+					GKTrace::record(_id, TracePhase::TRACE_END, _arg);
+				}
+
+				/* reported on the end record */
+				void setArg(const int32_t arg) noexcept { _arg = arg; }
+
+			private:
+				const TraceEventID _id;
+				int32_t _arg = 0;
+		};
+
+	protected:
+
+	private:
+		GKTrace(void) = delete;
+
+		static std::atomic<bool> _enabled;
+		static std::atomic<bool> _dumpRequested;
+		static std::string _file;
+
+		/* rings are kept after their thread exit, until the next
+		 * export, then released (see ::pruneExitedThreadsRings()) */
+		static std::mutex _ringsMutex;
+		static std::vector<std::shared_ptr<TraceRing>> _rings;
+
+		static void push(
+			const TraceEventID id,
+			const TracePhase phase,
+			const int32_t arg
+		) noexcept;
+		static TraceRing* getThreadRing(void) noexcept;
+		static void pruneExitedThreadsRings(void) noexcept;
+		static void exportAtExit(void) noexcept;
+
+		static const char* getEventName(const TraceEventID id) noexcept;
+};
+
+} // namespace NSGKUtils
+
+#endif
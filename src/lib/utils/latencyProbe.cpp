@@ -0,0 +1,164 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <ctime>
+#include <cstdlib>
+
+#include <fstream>
+#include <new>
+
+#include <config.h>
+
+#define UTILS_COMPILATION 1
+
+#include "GKLogging.hpp"
+#include "exception.hpp"
+#include "latencyProbe.hpp"
+
+#undef UTILS_COMPILATION
+
+namespace NSGKUtils
+{
+
+std::atomic<bool> LatencyProbe::_enabled(false);
+std::mutex LatencyProbe::_recordsMutex;
+std::vector<LatencyProbe::Record> LatencyProbe::_records;
+uint64_t LatencyProbe::_droppedRecords = 0;
+std::string LatencyProbe::_file;
+
+void LatencyProbe::open(const std::string & file)
+{
+	std::lock_guard<std::mutex> lock(_recordsMutex);
+
+	if( _enabled )
+		return;
+
+	/* check now that the file can be written, records are written on exit */
+	std::ofstream ofs(file, std::ios_base::out | std::ios_base::trunc);
+	if( ! ofs.is_open() )
+		throw GLogiKExcept("failed to open latency probe file");
+
+	try {
+		/* no reallocation on the hot path */
+		_records.reserve(LATENCY_PROBE_MAX_RECORDS);
+	}
+	catch (const std::bad_alloc& e) { /* handle new() failure */
+		throw GLogiKBadAlloc("latency records allocation failure");
+	}
+
+	_file = file;
+	_enabled = true;
+
+	std::atexit(LatencyProbe::close);
+}
+
+void LatencyProbe::close(void) noexcept
+{
+	std::lock_guard<std::mutex> lock(_recordsMutex);
+
+	if( ! _enabled )
+		return;
+
+	_enabled = false;
+
+	std::ofstream ofs(_file, std::ios_base::out | std::ios_base::trunc);
+	for(const auto & record : _records) {
+		ofs	<< LatencyProbe::getFlowName(record.flow) << " "
+			<< LatencyProbe::getStageName(record.stage) << " "
+			<< record.timestamp << "\n";
+	}
+
+	_records.clear();
+
+	if(_droppedRecords > 0) {
+		try {
+			GKSysLogWarning("latency probe full, dropped records : ", std::to_string(_droppedRecords));
+		}
+		catch (const std::exception & e) {
+		}
+		_droppedRecords = 0;
+	}
+}
+
+const uint64_t LatencyProbe::now(void) noexcept
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec);
+}
+
+void LatencyProbe::mark(
+	const LatencyFlow flow,
+	const LatencyStage stage,
+	const uint64_t timestamp) noexcept
+{
+	std::lock_guard<std::mutex> lock(_recordsMutex);
+
+	if( ! _enabled )
+		return;
+
+	if(_records.size() >= LATENCY_PROBE_MAX_RECORDS) {
+		_droppedRecords++;
+		return;
+	}
+
+	/* capacity reserved in ::open(), never reallocates */
+	_records.push_back( {timestamp, flow, stage} );
+}
+
+const char* LatencyProbe::getFlowName(const LatencyFlow flow) noexcept
+{
+	switch(flow) {
+		case LatencyFlow::LATENCY_GKEY:
+			return "gkey";
+		case LatencyFlow::LATENCY_MKEY:
+			return "mkey";
+		case LatencyFlow::LATENCY_MEDIA:
+			return "media";
+		case LatencyFlow::LATENCY_MACRO_RECORD:
+			return "macro-record";
+	}
+
+	return "unknown";
+}
+
+const char* LatencyProbe::getStageName(const LatencyStage stage) noexcept
+{
+	switch(stage) {
+		case LatencyStage::STAGE_REPORT:
+			return "report";
+		case LatencyStage::STAGE_DECODED:
+			return "decoded";
+		case LatencyStage::STAGE_SIGNAL_SENT:
+			return "sent";
+		case LatencyStage::STAGE_SIGNAL_RECEIVED:
+			return "received";
+		case LatencyStage::STAGE_EVENT_RUN:
+			return "run";
+		case LatencyStage::STAGE_OUTPUT:
+			return "output";
+	}
+
+	return "unknown";
+}
+
+} // namespace NSGKUtils
@@ -0,0 +1,114 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SRC_LIB_UTILS_LATENCY_PROBE_HPP_
+#define SRC_LIB_UTILS_LATENCY_PROBE_HPP_
+
+#if !defined (UTILS_INSIDE_UTILS_H) && !defined (UTILS_COMPILATION)
+#error "Only "utils/utils.hpp" can be included directly, this file may disappear or change contents."
+#endif
+
+#include <cstdint>
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <mutex>
+
+/* hard cap, records are allocated once */
+#define LATENCY_PROBE_MAX_RECORDS (1 << 18)
+
+namespace NSGKUtils
+{
+
+enum class LatencyFlow : uint8_t
+{
+	LATENCY_GKEY = 0,
+	LATENCY_MKEY,
+	LATENCY_MEDIA,
+	LATENCY_MACRO_RECORD,
+};
+
+enum class LatencyStage : uint8_t
+{
+	STAGE_REPORT = 0,		/* daemon, interrupt report read */
+	STAGE_DECODED,			/* daemon, report decoded */
+	STAGE_SIGNAL_SENT,		/* daemon, D-Bus signal sent */
+	STAGE_SIGNAL_RECEIVED,	/* service, D-Bus signal received */
+	STAGE_EVENT_RUN,		/* service, event handling started */
+	STAGE_OUTPUT,			/* service, first uinput or XTest event written */
+};
+
+/*
+ * Key events latency probes, disabled unless ::open() is called.
+ * Timestamps are CLOCK_MONOTONIC nanoseconds, so that records from
+ * the daemon and the desktop service can be merged. Records are
+ * kept in memory and written to the file on exit, one per line :
+ *   <flow> <stage> <timestamp>
+ * Once LATENCY_PROBE_MAX_RECORDS are kept, new records are dropped.
+ */
+class LatencyProbe
+{
+	public:
+		static void open(const std::string & file);
+		static void close(void) noexcept;
+
+		static const bool isEnabled(void) noexcept {
+			return _enabled.load(std::memory_order_relaxed);
+		}
+
+		static const uint64_t now(void) noexcept;
+
+		static void mark(
+			const LatencyFlow flow,
+			const LatencyStage stage,
+			const uint64_t timestamp
+		) noexcept;
+
+		static void mark(const LatencyFlow flow, const LatencyStage stage) noexcept {
+			if( LatencyProbe::isEnabled() )
+				LatencyProbe::mark(flow, stage, LatencyProbe::now());
+		}
+
+	protected:
+
+	private:
+		struct Record
+		{
+			uint64_t timestamp;
+			LatencyFlow flow;
+			LatencyStage stage;
+		};
+
+		static std::atomic<bool> _enabled;
+		static std::mutex _recordsMutex;
+		static std::vector<Record> _records;
+		static uint64_t _droppedRecords;
+		static std::string _file;
+
+		static const char* getFlowName(const LatencyFlow flow) noexcept;
+		static const char* getStageName(const LatencyStage stage) noexcept;
+};
+
+} // namespace NSGKUtils
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#include <algorithm>
+
+#include <config.h>
+
+#define UTILS_COMPILATION 1
+
+#include "metricsHistogram.hpp"
+
+#undef UTILS_COMPILATION
+
+namespace NSGKUtils
+{
+
+MetricsHistogram::MetricsHistogram(void)
+	:	_count(0),
+		_sum(0),
+		_max(0)
+{
+	for(auto & bucket : _buckets)
+		bucket.store(0, std::memory_order_relaxed);
+}
+
+void MetricsHistogram::add(const std::chrono::nanoseconds & duration) noexcept
+{
+	const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	const uint64_t value = (us > 0) ? static_cast<uint64_t>(us) : 0;
+
+	unsigned int index = 0;
+	for(uint64_t v = value >> 1; (v != 0) and (index < _bucketsNumber - 1); v >>= 1)
+		index++;
+
+	_buckets[index].fetch_add(1, std::memory_order_relaxed);
+	_sum.fetch_add(value, std::memory_order_relaxed);
+	_count.fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t max = _max.load(std::memory_order_relaxed);
+	while( (value > max) and
+		(! _max.compare_exchange_weak(max, value, std::memory_order_relaxed)) );
+}
+
+const uint64_t MetricsHistogram::getPercentile(
+	const std::array<uint64_t, _bucketsNumber> & buckets,
+	const uint64_t count,
+	const unsigned int percent) const noexcept
+{
+	if(count == 0)
+		return 0;
+
+	/* rank of the requested percentile, rounded up */
+	const uint64_t rank = (count * percent + 99) / 100;
+
+	uint64_t total = 0;
+	for(unsigned int i = 0; i < _bucketsNumber; ++i) {
+		total += buckets[i];
+		if(total >= rank)
+			return (static_cast<uint64_t>(1) << (i + 1));
+	}
+
+	return (static_cast<uint64_t>(1) << _bucketsNumber);
+}
+
+void MetricsHistogram::appendTo(
+	std::vector<std::string> & metrics,
+	const std::string & name) const
+{
+	/* buckets may be updated while reading, use one snapshot
+	 * so that percentiles are consistent with the count */
+	std::array<uint64_t, _bucketsNumber> buckets;
+	uint64_t count = 0;
+	for(unsigned int i = 0; i < _bucketsNumber; ++i) {
+		buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+		count += buckets[i];
+	}
+
+	uint64_t max = _max.load(std::memory_order_relaxed);
+	if(count == 0)
+		max = 0;
+
+	metrics.push_back(name + ".count=" + std::to_string(count));
+	metrics.push_back(name + ".sum_us=" + std::to_string(_sum.load(std::memory_order_relaxed)));
+	/* bucket upper bounds may exceed the largest recorded duration */
+	const uint64_t p50 = std::min(this->getPercentile(buckets, count, 50), max);
+	const uint64_t p99 = std::min(this->getPercentile(buckets, count, 99), max);
+
+	metrics.push_back(name + ".p50_us=" + std::to_string(p50));
+	metrics.push_back(name + ".p99_us=" + std::to_string(p99));
+	metrics.push_back(name + ".max_us=" + std::to_string(max));
+}
+
+} // namespace NSGKUtils
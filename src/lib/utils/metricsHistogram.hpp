@@ -0,0 +1,86 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+
+#ifndef SRC_LIB_UTILS_METRICS_HISTOGRAM_HPP_
+#define SRC_LIB_UTILS_METRICS_HISTOGRAM_HPP_
+
+#if !defined (UTILS_INSIDE_UTILS_H) && !defined (UTILS_COMPILATION)
+#error "Only "utils/utils.hpp" can be included directly, this file may disappear or change contents."
+#endif
+
+#include <cstdint>
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+
+namespace NSGKUtils
+{
+
+/*
+ * Lock-free durations histogram, with power of two microseconds
+ * buckets. Bucket N counts durations in [2^N, 2^(N+1)) microseconds,
+ * the first one also counts durations below 1 microsecond and the
+ * last one everything above. Percentiles are estimated using the
+ * upper bound of the bucket they fall in.
+ */
+class MetricsHistogram
+{
+	public:
+		MetricsHistogram(void);
+		~MetricsHistogram(void) = default;
+
+		void add(const std::chrono::nanoseconds & duration) noexcept;
+
+		const uint64_t getCount(void) const noexcept {
+			return _count.load(std::memory_order_relaxed);
+		}
+
+		/* appends <name>.{count,sum_us,p50_us,p99_us,max_us}=<value> */
+		void appendTo(
+			std::vector<std::string> & metrics,
+			const std::string & name
+		) const;
+
+	protected:
+
+	private:
+		static constexpr unsigned int _bucketsNumber = 24;
+
+		std::array<std::atomic<uint64_t>, _bucketsNumber> _buckets;
+		std::atomic<uint64_t> _count;
+		std::atomic<uint64_t> _sum;		/* microseconds */
+		std::atomic<uint64_t> _max;		/* microseconds */
+
+		const uint64_t getPercentile(
+			const std::array<uint64_t, _bucketsNumber> & buckets,
+			const uint64_t count,
+			const unsigned int percent
+		) const noexcept;
+};
+
+} // namespace NSGKUtils
+
+#endif
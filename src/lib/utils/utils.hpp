@@ -34,6 +34,9 @@
 #include "filesystem.hpp"
 #include "randomGenerator.hpp"
 #include "process.hpp"
+#include "latencyProbe.hpp"
+#include "metricsHistogram.hpp"
+#include "GKTrace.hpp"
 
 #undef UTILS_INSIDE_UTILS_H
 
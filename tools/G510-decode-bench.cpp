@@ -0,0 +1,286 @@
+/*
+ *
+ *	This file is part of GLogiK project.
+ *	GLogiK, daemon to handle special features on gaming keyboards
+ *	Copyright (C) 2016-2025  Fabrice Delliaux <netbox253@gmail.com>
+ *
+ *	This program is free software: you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation, either version 3 of the License, or
+ *	(at your option) any later version.
+ *
+ *	This program is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * G510 keys reports decoding microbenchmark, part of GLogiK project
+ *
+ * Replays the keys reports recorded in USB simulator scripts (see
+ * src/bin/daemon/simusb.cpp) through the recognized keys lookup tables
+ * used by the daemon, and through the per-key loops they replaced.
+ * Both decoders must agree on every report.
+ *
+ * build, from the top source directory :
+ *   g++ -std=c++17 -O2 -Isrc -o G510-decode-bench tools/G510-decode-bench.cpp
+ *
+ * usage : G510-decode-bench [-n reports] <script> [<script> ...]
+ *   tools/simusb-G510.script, tools/simusb-latency.script
+ */
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "bin/daemon/RKeys.hpp"
+#include "bin/daemon/logitechG510Keys.hpp"
+
+using namespace GLogiK;
+
+struct Report
+{
+	std::array<unsigned char, 8> bytes{};
+	std::size_t length = 0;
+};
+
+/* per report result : recognized keys, then G, M, LCD and media keys */
+struct Decoded
+{
+	uint64_t keys = 0;
+	uint64_t GKey = 0;
+	uint64_t MKey = 0;
+	uint64_t LCDKey = 0;
+	uint64_t mediaKey = 0;
+
+	const bool operator == (const Decoded & d) const {
+		return (keys == d.keys) and (GKey == d.GKey) and (MKey == d.MKey)
+			and (LCDKey == d.LCDKey) and (mediaKey == d.mediaKey);
+	}
+};
+
+static constexpr uint64_t MKeysMask = getRKeysMask(G510Keys::MKeys5BytesMap);
+
+/* same parsing rules than simusb::parseReport() */
+static void loadScript(const std::string & file, std::vector<Report> & reports)
+{
+	std::ifstream ifs(file);
+	if( ! ifs.is_open() )
+		throw std::runtime_error("failed to open script : " + file);
+
+	std::string line;
+	while( std::getline(ifs, line) ) {
+		const std::size_t comment = line.find('#');
+		if(comment != std::string::npos)
+			line.erase(comment);
+
+		std::istringstream iss(line);
+		std::string statement;
+		if( ! (iss >> statement) or (statement != "keys") )
+			continue;
+
+		std::string bytes;
+		std::getline(iss >> std::ws, bytes);
+		std::replace(bytes.begin(), bytes.end(), ',', ' ');
+
+		Report report;
+		std::istringstream byteStream(bytes);
+		std::string byte;
+		while( byteStream >> byte ) {
+			const unsigned long value = std::stoul(byte, nullptr, 16);
+			if( (value > 0xFF) or (report.length == report.bytes.size()) )
+				throw std::runtime_error("wrong report in script : " + file);
+			report.bytes[report.length++] = static_cast<unsigned char>(value);
+		}
+		if(report.length > 0)
+			reports.push_back(report);
+	}
+}
+
+/* -- -- -- loops, decoding before lookup tables -- -- -- */
+
+template <std::size_t N>
+	static void loopDecode(
+		const Report & report,
+		const std::array<RKey, N> & keys,
+		uint64_t & mask)
+{
+	for(const auto & key : keys) {
+		if( report.bytes[key.index] & key.mask )
+			mask |= static_cast<uint64_t>(key.key);
+	}
+}
+
+template <std::size_t N>
+	static uint64_t loopFirstKey(
+		const uint64_t mask,
+		const std::array<RKey, N> & keys)
+{
+	for(const auto & key : keys) {
+		if( mask & static_cast<uint64_t>(key.key) )
+			return static_cast<uint64_t>(key.key);
+	}
+	return 0;
+}
+
+static Decoded decodeLoops(const Report & report)
+{
+	Decoded d;
+
+	if( (report.length == 5) and (report.bytes[0] == 0x03) ) {
+		loopDecode(report, G510Keys::keys5BytesMap, d.keys);
+		loopDecode(report, G510Keys::MKeys5BytesMap, d.keys);
+		loopDecode(report, G510Keys::GKeys5BytesMap, d.keys);
+		loopDecode(report, G510Keys::LCDKeys5BytesMap, d.keys);
+	}
+	else if( (report.length == 2) and (report.bytes[0] == 0x02) ) {
+		loopDecode(report, G510Keys::mediaKeys2BytesMap, d.keys);
+	}
+
+	if(d.keys == 0)
+		return d;
+
+	d.GKey = loopFirstKey(d.keys, G510Keys::GKeys5BytesMap);
+	d.LCDKey = loopFirstKey(d.keys, G510Keys::LCDKeys5BytesMap);
+	d.mediaKey = loopFirstKey(d.keys, G510Keys::mediaKeys2BytesMap);
+
+	if( d.keys & static_cast<uint64_t>(Keys::GK_KEY_M1) )
+		d.MKey = static_cast<uint64_t>(Keys::GK_KEY_M1);
+	else if( d.keys & static_cast<uint64_t>(Keys::GK_KEY_M2) )
+		d.MKey = static_cast<uint64_t>(Keys::GK_KEY_M2);
+	else if( d.keys & static_cast<uint64_t>(Keys::GK_KEY_M3) )
+		d.MKey = static_cast<uint64_t>(Keys::GK_KEY_M3);
+
+	return d;
+}
+
+/* -- -- -- lookup tables, as in G510Base -- -- -- */
+
+static uint64_t firstKey(const uint64_t keys)
+{
+	return (keys == 0) ? 0 : static_cast<uint64_t>(getFirstRKey(keys));
+}
+
+static Decoded decodeTables(const Report & report)
+{
+	Decoded d;
+
+	if( (report.length == 5) and (report.bytes[0] == 0x03) ) {
+		d.keys =
+			G510Keys::keys5BytesTables[1][report.bytes[1]] |
+			G510Keys::keys5BytesTables[2][report.bytes[2]] |
+			G510Keys::keys5BytesTables[3][report.bytes[3]] |
+			G510Keys::keys5BytesTables[4][report.bytes[4]];
+	}
+	else if( (report.length == 2) and (report.bytes[0] == 0x02) ) {
+		d.keys = G510Keys::keys2BytesTables[1][report.bytes[1]];
+	}
+
+	if(d.keys == 0)
+		return d;
+
+	d.GKey = firstKey(d.keys & G510Keys::GKeysMask);
+	d.LCDKey = firstKey(d.keys & G510Keys::LCDKeysMask);
+	d.mediaKey = firstKey(d.keys & G510Keys::mediaKeysMask);
+	d.MKey = firstKey(d.keys & MKeysMask);
+
+	return d;
+}
+
+/* -- -- -- -- -- -- */
+
+template <typename Decoder>
+	static double replay(
+		const std::vector<Report> & reports,
+		const std::size_t count,
+		Decoder decode,
+		uint64_t & checksum)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	uint64_t sum = 0;
+	for(std::size_t i = 0, r = 0; i < count; ++i) {
+		const Decoded d = decode(reports[r]);
+		sum += d.keys ^ d.GKey ^ (d.MKey << 1) ^ (d.LCDKey << 2) ^ (d.mediaKey << 3);
+		if(++r == reports.size())
+			r = 0;
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	checksum = sum;
+
+	return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+int main(int argc, char *argv[])
+{
+	std::size_t count = 10000000;
+	std::vector<std::string> scripts;
+
+	for(int i = 1; i < argc; ++i) {
+		const std::string arg(argv[i]);
+		if( (arg == "-n") and (i + 1 < argc) )
+			count = std::stoul(argv[++i]);
+		else
+			scripts.push_back(arg);
+	}
+
+	if( scripts.empty() or (count == 0) ) {
+		std::cerr << "usage : " << argv[0] << " [-n reports] <script> [<script> ...]\n";
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Report> reports;
+	try {
+		for(const auto & script : scripts)
+			loadScript(script, reports);
+	}
+	catch (const std::exception & e) {
+		std::cerr << e.what() << "\n";
+		return EXIT_FAILURE;
+	}
+
+	if( reports.empty() ) {
+		std::cerr << "no keys reports found\n";
+		return EXIT_FAILURE;
+	}
+
+	for(const auto & report : reports) {
+		if( ! (decodeLoops(report) == decodeTables(report)) ) {
+			std::cerr << "decoders mismatch\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	uint64_t loopsSum = 0, tablesSum = 0;
+	/* warm up */
+	replay(reports, reports.size(), decodeTables, tablesSum);
+
+	const double loops = replay(reports, count, decodeLoops, loopsSum);
+	const double tables = replay(reports, count, decodeTables, tablesSum);
+
+	if(loopsSum != tablesSum) {
+		std::cerr << "checksums mismatch\n";
+		return EXIT_FAILURE;
+	}
+
+	std::cout	<< reports.size() << " recorded reports, " << count << " replayed\n"
+				<< "loops  : " << loops << " ns/report\n"
+				<< "tables : " << tables << " ns/report\n";
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+#!/bin/bash
+# helper script, part of GLogiK project
+#
+# key events latency benchmark, requires a daemon built with the USB
+# simulator backend (--enable-usb-simulator or -Dusb-simulator=true) :
+#  - starts a private dbus-daemon, used as both system and session bus
+#  - starts logind-stub.py on it, providing GLogiKs an active session
+#  - starts GLogiKd replaying simusb-latency.script, and GLogiKs
+#  - merges the latency probes of both processes and reports, for each
+#    flow and stage, the p50/p99/p99.9 latency since the interrupt report
+#
+# GLogiKd drops its privileges, so this must be run as root. The logind
+# stub requires PyGObject. Use -n to benchmark the daemon alone.
+#
+# exits with a non-zero status when one of the programs dies during the
+# run, or when a flow sent by the daemon is never received and run by
+# the service. The output stage needs a macro on the replayed G-Key.
+#
+# usage : latency-bench.sh [-n] [-t seconds] <GLogiKd path> <GLogiKs path>
+
+declare -i DURATION=30
+declare -i WITH_SERVICE=1
+
+while getopts "nt:" opt; do
+	case "${opt}" in
+		n) WITH_SERVICE=0 ;;
+		t) DURATION="${OPTARG}" ;;
+		*) exit 7 ;;
+	esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -lt 2 ]; then
+	printf "usage : $0 [-n] [-t seconds] <GLogiKd path> <GLogiKs path>\n"
+	exit 7
+fi
+
+declare -r DAEMON="$1"
+declare -r SERVICE="$2"
+declare -r TOOLS="$(dirname "$(readlink -f "$0")")"
+declare -r SCRIPT="${TOOLS}/simusb-latency.script"
+declare -r WORKDIR="$(mktemp -d /tmp/GLogiK-latency.XXXXXX)" || exit 5
+chmod 0777 "${WORKDIR}"
+
+STUB_PID=""
+SERVICE_PID=""
+
+# kill everything still running, probes are kept
+function cleanup() {
+	[ -n "${SERVICE_PID}" ] && kill -TERM ${SERVICE_PID} 2>/dev/null
+	[ -f "${WORKDIR}/GLogiKd.pid" ] && kill -TERM "$(cat "${WORKDIR}/GLogiKd.pid")" 2>/dev/null
+	[ -n "${STUB_PID}" ] && kill -TERM ${STUB_PID} 2>/dev/null
+	[ -f "${WORKDIR}/bus.pid" ] && kill -TERM "$(cat "${WORKDIR}/bus.pid")" 2>/dev/null
+}
+
+function fail() {
+	printf "error : $1\n" >&2
+	printf "raw probes and logs kept in ${WORKDIR}\n" >&2
+	cleanup
+	exit 5
+}
+
+# zombies are dead too
+function isAlive() {
+	[ -n "$1" ] || return 1
+	local state="$(ps -o stat= -p "$1" 2>/dev/null)"
+	[ -n "${state}" ] && [ "${state:0:1}" != "Z" ]
+}
+
+function daemonPID() {
+	cat "${WORKDIR}/GLogiKd.pid" 2>/dev/null
+}
+
+# --
+
+cat > "${WORKDIR}/bus.conf" <<'CONF'
+<!DOCTYPE busconfig PUBLIC "-//freedesktop//DTD D-Bus Bus Configuration 1.0//EN"
+ "http://www.freedesktop.org/standards/dbus/1.0/busconfig.dtd">
+<busconfig>
+	<type>session</type>
+	<listen>unix:tmpdir=/tmp</listen>
+	<auth>EXTERNAL</auth>
+	<policy context="default">
+		<allow user="*"/>
+		<allow own="*"/>
+		<allow send_destination="*" eavesdrop="true"/>
+		<allow receive_sender="*"/>
+	</policy>
+</busconfig>
+CONF
+
+BUS_ADDRESS="$(dbus-daemon --config-file="${WORKDIR}/bus.conf" --fork --print-address --print-pid=3 3>"${WORKDIR}/bus.pid")" || exit 5
+export DBUS_SYSTEM_BUS_ADDRESS="${BUS_ADDRESS}"
+export DBUS_SESSION_BUS_ADDRESS="${BUS_ADDRESS}"
+
+printf "private bus : ${BUS_ADDRESS}\n"
+
+# GLogiKd sleep inhibition and GLogiKs session both need logind
+/usr/bin/env python3 "${TOOLS}/logind-stub.py" 2>"${WORKDIR}/logind-stub.log" &
+STUB_PID=$!
+
+declare -i tries=0
+until dbus-send --bus="${BUS_ADDRESS}" --print-reply --dest=org.freedesktop.DBus / \
+		org.freedesktop.DBus.NameHasOwner string:org.freedesktop.login1 2>/dev/null | grep -q "true"; do
+	isAlive ${STUB_PID} || fail "logind stub died, see ${WORKDIR}/logind-stub.log"
+	tries+=1
+	[ ${tries} -gt 50 ] && fail "logind stub did not own its bus name"
+	sleep 0.1
+done
+
+"${DAEMON}" -d -p "${WORKDIR}/GLogiKd.pid" -S "${SCRIPT}" -L "${WORKDIR}/daemon.lat" || fail "GLogiKd failed to start"
+sleep 1
+isAlive "$(daemonPID)" || fail "GLogiKd died on startup"
+
+if [ ${WITH_SERVICE} -eq 1 ]; then
+	"${SERVICE}" -L "${WORKDIR}/service.lat" 2>"${WORKDIR}/GLogiKs.log" &
+	SERVICE_PID=$!
+fi
+
+printf "running for ${DURATION} seconds ...\n"
+for (( i = 0; i < DURATION; i++ )); do
+	sleep 1
+	isAlive "$(daemonPID)" || fail "GLogiKd died during the run"
+	if [ ${WITH_SERVICE} -eq 1 ]; then
+		isAlive ${SERVICE_PID} || fail "GLogiKs died during the run, see ${WORKDIR}/GLogiKs.log"
+	fi
+done
+
+# SIGUSR1 and SIGTERM trigger a clean exit, probes are written on exit
+if [ ${WITH_SERVICE} -eq 1 ]; then
+	kill -USR1 ${SERVICE_PID}
+	wait ${SERVICE_PID} || fail "GLogiKs exited with status $?"
+	SERVICE_PID=""
+fi
+kill -TERM "$(daemonPID)"
+sleep 2
+isAlive "$(daemonPID)" && fail "GLogiKd still running"
+rm -f "${WORKDIR}/GLogiKd.pid"
+cleanup
+
+# --
+
+# latencies in microseconds since the last report of the same flow
+sort -n -k3,3 "${WORKDIR}"/*.lat | awk -v samples="${WORKDIR}/samples" '
+	$2 == "report" {
+		report[$1] = $3
+		if( ! ($1 in first) ) first[$1] = $3
+		next
+	}
+	($1 in report) {
+		printf "%s %s %.3f\n", $1, $2, ($3 - report[$1]) / 1000.0 > samples
+		if( $2 == "sent" ) { count[$1]++; last[$1] = $3 }
+	}
+	END {
+		printf "\n%-14s %8s %12s\n", "flow", "events", "events/s"
+		for(f in count) {
+			rate = (last[f] > first[f]) ? count[f] * 1e9 / (last[f] - first[f]) : 0
+			printf "%-14s %8d %12.2f\n", f, count[f], rate
+		}
+	}'
+
+printf "\n%-14s %-9s %8s %10s %10s %10s\n" "flow" "stage" "samples" "p50 us" "p99 us" "p99.9 us"
+for flow in gkey mkey media macro-record; do
+	for stage in decoded sent received run output; do
+		awk -v f="${flow}" -v s="${stage}" '$1 == f && $2 == s { print $3 }' "${WORKDIR}/samples" \
+			| sort -n | awk -v f="${flow}" -v s="${stage}" '
+			{ v[NR] = $1 }
+			function pct(p,    i) { i = int(p * NR + 0.999999); if(i < 1) i = 1; return v[i] }
+			END {
+				if(NR > 0)
+					printf "%-14s %-9s %8d %10.1f %10.1f %10.1f\n", f, s, NR, pct(0.5), pct(0.99), pct(0.999)
+			}'
+	done
+done
+
+printf "\nraw probes kept in ${WORKDIR}\n"
+
+[ -s "${WORKDIR}/samples" ] || fail "no event sent by the daemon"
+
+# every flow sent by the daemon must be received and run by the service
+if [ ${WITH_SERVICE} -eq 1 ]; then
+	declare -i missing=0
+	for flow in $(awk '$2 == "sent" { print $1 }' "${WORKDIR}/samples" | sort -u); do
+		for stage in received run; do
+			if ! grep -q "^${flow} ${stage} " "${WORKDIR}/samples"; then
+				printf "error : no ${stage} stage for ${flow} events\n" >&2
+				missing+=1
+			fi
+		done
+	done
+	[ ${missing} -eq 0 ] || exit 5
+fi
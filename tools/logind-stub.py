@@ -0,0 +1,94 @@
+#!/usr/bin/python3
+# helper script, part of GLogiK project
+#
+# minimal logind stub, used by latency-bench.sh on its private bus :
+#  - org.freedesktop.login1.Manager : GetSessionByPID, Inhibit
+#  - one always active org.freedesktop.login1.Session, with its
+#    State and Active properties
+#
+# requires PyGObject (gi), owns org.freedesktop.login1 on the bus
+# given by DBUS_SYSTEM_BUS_ADDRESS until killed
+#
+# usage : logind-stub.py
+
+import os
+import sys
+
+from gi.repository import Gio, GLib
+
+BUS_NAME = "org.freedesktop.login1"
+MANAGER_PATH = "/org/freedesktop/login1"
+SESSION_PATH = "/org/freedesktop/login1/session/bench"
+
+INTROSPECTION = """
+<node>
+	<interface name="org.freedesktop.login1.Manager">
+		<method name="GetSessionByPID">
+			<arg name="pid" type="u" direction="in"/>
+			<arg name="session" type="o" direction="out"/>
+		</method>
+		<method name="Inhibit">
+			<arg name="what" type="s" direction="in"/>
+			<arg name="who" type="s" direction="in"/>
+			<arg name="why" type="s" direction="in"/>
+			<arg name="mode" type="s" direction="in"/>
+			<arg name="fd" type="h" direction="out"/>
+		</method>
+		<signal name="PrepareForSleep">
+			<arg name="start" type="b"/>
+		</signal>
+	</interface>
+	<interface name="org.freedesktop.login1.Session">
+		<property name="State" type="s" access="read"/>
+		<property name="Active" type="b" access="read"/>
+	</interface>
+</node>
+"""
+
+SESSION_PROPERTIES = {
+	"State": GLib.Variant("s", "active"),
+	"Active": GLib.Variant("b", True),
+}
+
+# inhibitor locks are released when the last copy of the write end is closed
+inhibitors = []
+
+def manager_call(connection, sender, path, interface, method, params, invocation):
+	if method == "GetSessionByPID":
+		invocation.return_value(GLib.Variant("(o)", (SESSION_PATH,)))
+	elif method == "Inhibit":
+		rfd, wfd = os.pipe()
+		inhibitors.append(rfd)
+		fds = Gio.UnixFDList.new_from_array([wfd])
+		invocation.return_value_with_unix_fd_list(GLib.Variant("(h)", (0,)), fds)
+	else:
+		invocation.return_dbus_error("org.freedesktop.DBus.Error.UnknownMethod", method)
+
+def session_get_property(connection, sender, path, interface, name):
+	return SESSION_PROPERTIES.get(name)
+
+def on_name_lost(connection, name):
+	sys.stderr.write("logind stub : unable to own %s\n" % name)
+	loop.quit()
+
+address = os.environ.get("DBUS_SYSTEM_BUS_ADDRESS")
+if not address:
+	sys.stderr.write("logind stub : DBUS_SYSTEM_BUS_ADDRESS is not set\n")
+	sys.exit(7)
+
+connection = Gio.DBusConnection.new_for_address_sync(
+	address,
+	Gio.DBusConnectionFlags.AUTHENTICATION_CLIENT | Gio.DBusConnectionFlags.MESSAGE_BUS_CONNECTION,
+	None, None)
+
+node = Gio.DBusNodeInfo.new_for_xml(INTROSPECTION)
+connection.register_object(MANAGER_PATH, node.lookup_interface("org.freedesktop.login1.Manager"),
+	manager_call, None, None)
+connection.register_object(SESSION_PATH, node.lookup_interface("org.freedesktop.login1.Session"),
+	None, session_get_property, None)
+
+loop = GLib.MainLoop()
+Gio.bus_own_name_on_connection(connection, BUS_NAME, Gio.BusNameOwnerFlags.DO_NOT_QUEUE,
+	None, on_name_lost)
+loop.run()
+sys.exit(5)